@@ -0,0 +1,984 @@
+#include "jujson.hpp"
+#include <chrono>
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <new>
+#include <string>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+static const std::string record = R"({"name":"JohnDoe","age":30,"isEmployed":true,"address":{"street":"123MainSt","city":"Anytown","state":"CA","postalCode":"12345"},"phoneNumbers":[{"type":"home","number":"555-1234"},{"type":"work","number":"555-5678"}],"children":["Jane","Doe"],"spouse":null,"salary":50000.50,"projects":[{"name":"ProjectAlpha","status":"completed","team":["Alice","Bob","Charlie"]},{"name":"ProjectBeta","status":"inprogress","team":["David","Eve"]}]})";
+
+namespace bench {
+struct postal_address {
+    std::string street;
+    std::string city;
+    std::string state;
+    std::string postalCode;
+};
+JUJSON_BIND(postal_address, street, city, state, postalCode)
+struct phone_number {
+    std::string type;
+    std::string number;
+};
+JUJSON_BIND(phone_number, type, number)
+struct project {
+    std::string name;
+    std::string status;
+    std::vector<std::string> team;
+};
+JUJSON_BIND(project, name, status, team)
+struct person {
+    std::string name;
+    int age = 0;
+    bool isEmployed = false;
+    postal_address address;
+    std::vector<phone_number> phoneNumbers;
+    std::vector<std::string> children;
+    double salary = 0.0;
+    std::vector<project> projects;
+};
+JUJSON_BIND(person, name, age, isEmployed, address, phoneNumbers, children, salary, projects)
+}
+
+// main.cpp-style records, wrapped into {"records":[...]} up to the requested size.
+static std::string make_document(std::size_t size) {
+    std::string result = R"({"records":[)";
+    result.reserve(size + record.size() * 2);
+    while (result.size() < size) {
+        result += record;
+        result += ',';
+    }
+    result += record;
+    result += "]}";
+    return result;
+}
+
+// the same records, one per line.
+static std::string make_lines(std::size_t size) {
+    std::string result;
+    result.reserve(size + record.size() * 2);
+    while (result.size() < size) {
+        result += record;
+        result += '\n';
+    }
+    return result;
+}
+
+// telemetry-like records, mostly numbers.
+static std::string make_numbers(std::size_t size) {
+    std::string result = R"({"samples":[)";
+    result.reserve(size + 256);
+    for (std::size_t i = 0; result.size() < size; ++i) {
+        result += R"({"t":)" + std::to_string(1700000000000 + i) + R"(,"cpu":)" + std::to_string((i * 7919) % 10000 / 100.0) +
+            R"(,"mem":)" + std::to_string(i * 4096) + R"(,"load":[0.25,1.5e-3,-3.75,)" + std::to_string(i % 97) + "]},";
+    }
+    result.back() = ']';
+    result += '}';
+    return result;
+}
+
+// allocation counting: every operator new of the process, live bytes and the peak since the last measure.
+static std::atomic<std::size_t> allocationCount(0);
+static std::atomic<std::size_t> allocatedBytes(0);
+static std::atomic<std::size_t> liveBytes(0);
+static std::atomic<std::size_t> peakBytes(0);
+static const std::size_t allocationHeader = 16; // keeps the size, and the alignment of malloc
+
+static void* allocate(std::size_t size) noexcept {
+    char* block = static_cast<char*>(std::malloc(size + allocationHeader));
+    if (block == nullptr)
+        return nullptr;
+    *reinterpret_cast<std::size_t*>(block) = size;
+    allocationCount.fetch_add(1, std::memory_order_relaxed);
+    allocatedBytes.fetch_add(size, std::memory_order_relaxed);
+    const std::size_t live = liveBytes.fetch_add(size, std::memory_order_relaxed) + size;
+    std::size_t peak = peakBytes.load(std::memory_order_relaxed);
+    while ((live > peak) && !peakBytes.compare_exchange_weak(peak, live, std::memory_order_relaxed)) {
+    }
+    return block + allocationHeader;
+}
+static void deallocate(void* pointer) noexcept {
+    if (pointer == nullptr)
+        return;
+    char* block = static_cast<char*>(pointer) - allocationHeader;
+    liveBytes.fetch_sub(*reinterpret_cast<std::size_t*>(block), std::memory_order_relaxed);
+    std::free(block);
+}
+void* operator new(std::size_t size) {
+    void* result = allocate(size);
+    if (result == nullptr)
+        throw std::bad_alloc();
+    return result;
+}
+void* operator new[](std::size_t size) {
+    return operator new(size);
+}
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept {
+    return allocate(size);
+}
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept {
+    return allocate(size);
+}
+void operator delete(void* pointer) noexcept {
+    deallocate(pointer);
+}
+void operator delete[](void* pointer) noexcept {
+    deallocate(pointer);
+}
+void operator delete(void* pointer, std::size_t) noexcept {
+    deallocate(pointer);
+}
+void operator delete[](void* pointer, std::size_t) noexcept {
+    deallocate(pointer);
+}
+void operator delete(void* pointer, const std::nothrow_t&) noexcept {
+    deallocate(pointer);
+}
+void operator delete[](void* pointer, const std::nothrow_t&) noexcept {
+    deallocate(pointer);
+}
+#if (defined __cpp_aligned_new)
+// over-aligned allocations, e.g. the arenas of std::pmr: the block is aligned by hand, with its address kept right before the result.
+static void* allocate_aligned(std::size_t size, std::align_val_t alignment) noexcept {
+    const std::size_t align = static_cast<std::size_t>(alignment);
+    if (align <= allocationHeader)
+        return allocate(size);
+    char* block = static_cast<char*>(allocate(size + align));
+    if (block == nullptr)
+        return nullptr;
+    char* result = block + align - (reinterpret_cast<std::uintptr_t>(block) % align); // at least allocationHeader bytes after block
+    reinterpret_cast<char**>(result)[-1] = block;
+    return result;
+}
+static void deallocate_aligned(void* pointer, std::align_val_t alignment) noexcept {
+    if ((pointer == nullptr) || (static_cast<std::size_t>(alignment) <= allocationHeader))
+        return deallocate(pointer);
+    deallocate(static_cast<char**>(pointer)[-1]);
+}
+void* operator new(std::size_t size, std::align_val_t alignment) {
+    void* result = allocate_aligned(size, alignment);
+    if (result == nullptr)
+        throw std::bad_alloc();
+    return result;
+}
+void* operator new[](std::size_t size, std::align_val_t alignment) {
+    return operator new(size, alignment);
+}
+void* operator new(std::size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept {
+    return allocate_aligned(size, alignment);
+}
+void* operator new[](std::size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept {
+    return allocate_aligned(size, alignment);
+}
+void operator delete(void* pointer, std::align_val_t alignment) noexcept {
+    deallocate_aligned(pointer, alignment);
+}
+void operator delete[](void* pointer, std::align_val_t alignment) noexcept {
+    deallocate_aligned(pointer, alignment);
+}
+void operator delete(void* pointer, std::size_t, std::align_val_t alignment) noexcept {
+    deallocate_aligned(pointer, alignment);
+}
+void operator delete[](void* pointer, std::size_t, std::align_val_t alignment) noexcept {
+    deallocate_aligned(pointer, alignment);
+}
+void operator delete(void* pointer, std::align_val_t alignment, const std::nothrow_t&) noexcept {
+    deallocate_aligned(pointer, alignment);
+}
+void operator delete[](void* pointer, std::align_val_t alignment, const std::nothrow_t&) noexcept {
+    deallocate_aligned(pointer, alignment);
+}
+#endif
+
+struct measurement {
+    double seconds;
+    std::size_t allocations;
+    std::size_t allocatedBytes;
+    std::size_t peakBytes; // above the live bytes at the start
+};
+
+static bool jsonOutput = false; // one JSON object per line instead of text, --json
+
+// the stream for anything but results, kept out of machine-readable output.
+static std::ostream& info() {
+    return jsonOutput ? std::cerr : std::cout;
+}
+
+template<class FunctionT_>
+static measurement measure(FunctionT_ function) {
+    const std::size_t allocationsBefore = allocationCount.load();
+    const std::size_t bytesBefore = allocatedBytes.load();
+    const std::size_t liveBefore = liveBytes.load();
+    peakBytes.store(liveBefore);
+    const auto begin = std::chrono::steady_clock::now();
+    function();
+    const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+    return measurement{seconds, allocationCount.load() - allocationsBefore, allocatedBytes.load() - bytesBefore, peakBytes.load() - liveBefore};
+}
+
+static void report(const char* name, const measurement& result, std::size_t bytes, std::size_t documents = 1) {
+    const double megabytesPerSecond = (bytes / (1024.0 * 1024.0)) / result.seconds;
+    if (jsonOutput) {
+        const std::string escapedName = jujson::escape_json_string<std::string>(name, name + std::strlen(name));
+        std::cout << R"({"benchmark":")" << escapedName << R"(","bytes":)" << bytes << R"(,"documents":)" << documents << R"(,"seconds":)" << result.seconds <<
+            R"(,"mb_per_s":)" << megabytesPerSecond << R"(,"docs_per_s":)" << documents / result.seconds << R"(,"allocations":)" << result.allocations <<
+            R"(,"allocated_bytes":)" << result.allocatedBytes << R"(,"peak_bytes":)" << result.peakBytes << "}\n";
+        return;
+    }
+    std::cout << name << ": " << result.seconds * 1000.0 << " ms, " << megabytesPerSecond << " MB/s";
+    if (documents != 1)
+        std::cout << ", " << documents / result.seconds << " docs/s";
+    std::cout << ", " << result.allocations << " allocations, " << result.peakBytes / (1024.0 * 1024.0) << " MB peak\n";
+}
+
+// counts team members of all projects of all records.
+template<class JSONValueT_>
+static std::size_t iterate_tree(const JSONValueT_& root) {
+    std::size_t result = 0;
+    auto recordsKV = root.find("records");
+    for (const auto& record : recordsKV->value().get_childs()) {
+        auto projectsKV = record.find("projects");
+        for (const auto& project : projectsKV->value().get_childs()) {
+            auto teamKV = project.find("team");
+            result += teamKV->value().get_childs().size();
+        }
+    }
+    return result;
+}
+// parses each line as a message, returns the number of valid ones.
+template<class ParseT_>
+static std::size_t parse_messages(const std::string& lines, ParseT_ parse) {
+    std::size_t result = 0;
+    for (std::size_t b = 0, e = 0; b < lines.size(); b = e + 1) {
+        e = lines.find('\n', b);
+        if (e == std::string::npos)
+            e = lines.size();
+        result += parse(lines.begin() + b, lines.begin() + e) ? 1 : 0;
+    }
+    return result;
+}
+// decodes every key and string of the tree, returns the decoded size.
+static std::size_t decode_strings(const jujson::json_value<std::string>& value) {
+    std::size_t result = 0;
+    switch (value.kind()) {
+    case jujson::JUSJON_JSON_VALUE_STRING:
+        return value.decoded_data().size();
+    case jujson::JUSJON_JSON_VALUE_KEY:
+        return value.decoded_data().size() + decode_strings(value.value());
+    case jujson::JUSJON_JSON_VALUE_ARRAY:
+    case jujson::JUSJON_JSON_VALUE_OBJECT:
+        for (const auto& child : value.get_childs())
+            result += decode_strings(child);
+        return result;
+    default:
+        return 0;
+    }
+}
+static std::size_t iterate_tape(const jujson::json_tape<std::string>& tape) {
+    std::size_t result = 0;
+    auto recordsKV = tape.root().find("records");
+    for (const auto& record : recordsKV->value().get_childs()) {
+        auto projectsKV = record.find("projects");
+        for (const auto& project : projectsKV->value().get_childs()) {
+            auto teamKV = project.find("team");
+            for (const auto& member : teamKV->value().get_childs()) {
+                (void)member;
+                ++result;
+            }
+        }
+    }
+    return result;
+}
+
+// generated corpora in the style of the usual JSON benchmark files, deterministic and about size bytes each.
+struct corpus {
+    const char* name;
+    std::string text;
+};
+
+static std::uint32_t next_random(std::uint32_t& state) { // LCG, the same corpora on every run
+    state = state * 1664525u + 1013904223u;
+    return state >> 8;
+}
+
+// twitter.json: statuses with users and entities, unicode text, 64-bit ids.
+static std::string make_twitter(std::size_t size) {
+    static const char* const texts[] = {
+        R"(@aym0566x \u540d\u524d:\u524d\u7530\u3042\u3086\u307f \u7b2c\u4e00\u5370\u8c61:\u306a\u3093\u304b\u6016\u3063\uff01)",
+        R"(RT @KATANA77: \u3048\u3063\u305d\u3063\u3061\uff1f http://t.co/PkCJAcSuYK)",
+        R"(Check out the \"new\" release notes\nhttps:\/\/example.com\/notes #release #json)",
+    };
+    std::uint32_t state = 1;
+    std::string result = R"({"statuses":[)";
+    for (std::size_t i = 0; result.size() < size; ++i) {
+        const std::string id = std::to_string(505874924095815681ull + i * 7919);
+        const std::string userId = std::to_string(1186275104ull + next_random(state) % 100000);
+        result += (i != 0) ? "," : "";
+        result += R"({"metadata":{"result_type":"recent","iso_language_code":"ja"},"created_at":"Sun Aug 31 00:29:15 +0000 2014","id":)" + id + R"(,"id_str":")" + id +
+            R"(","text":")" + texts[next_random(state) % 3] + R"(","source":"<a href=\"http://twitter.com/download/iphone\" rel=\"nofollow\">Twitter for iPhone</a>",)" +
+            R"("truncated":false,"in_reply_to_status_id":null,"in_reply_to_user_id":null,"user":{"id":)" + userId + R"(,"id_str":")" + userId +
+            R"(","name":"AYUMI","screen_name":"ayuu)" + std::to_string(i) + R"(","location":"\u6771\u4eac","description":"\u3069\u3046\u305e\u3088\u308d\u3057\u304f",)" +
+            R"("url":null,"protected":false,"followers_count":)" + std::to_string(next_random(state) % 5000) + R"(,"friends_count":)" + std::to_string(next_random(state) % 2000) +
+            R"(,"created_at":"Mon Mar 12 05:28:02 +0000 2012","favourites_count":235,"utc_offset":null,"verified":false,"statuses_count":1769,"lang":"en",)" +
+            R"("profile_image_url":"http://pbs.twimg.com/profile_images/497760886795153410/LDjAwR_y_normal.jpeg","following":false},)" +
+            R"("geo":null,"coordinates":null,"place":null,"retweet_count":)" + std::to_string(next_random(state) % 100) + R"(,"favorite_count":0,)" +
+            R"("entities":{"hashtags":[{"text":"release","indices":[64,72]}],"symbols":[],"urls":[],"user_mentions":[{"screen_name":"aym0566x","name":"\u524d\u7530\u3042\u3086\u307f","id":)" +
+            userId + R"(,"indices":[0,9]}]},"favorited":false,"retweeted":false,"lang":"ja"})";
+    }
+    result += R"(],"search_metadata":{"completed_in":0.087,"max_id":505874924095815681,"query":"%E4%B8%80","count":100}})";
+    return result;
+}
+
+// canada.json: a feature collection of polygons, long arrays of coordinate pairs with full precision doubles.
+static std::string make_canada(std::size_t size) {
+    std::uint32_t state = 2;
+    std::string result = R"({"type":"FeatureCollection","features":[)";
+    char buffer[64];
+    for (std::size_t feature = 0; result.size() < size; ++feature) {
+        result += (feature != 0) ? "," : "";
+        result += R"({"type":"Feature","properties":{"name":"Canada"},"geometry":{"type":"Polygon","coordinates":[)";
+        for (int ring = 0; ring < 4; ++ring) {
+            result += (ring != 0) ? ",[" : "[";
+            for (int point = 0; point < 1000; ++point) {
+                const double x = -141.0 + (next_random(state) % 8800000) / 100000.0 + 1e-9 * (next_random(state) % 1000);
+                const double y = 41.0 + (next_random(state) % 4200000) / 100000.0 + 1e-9 * (next_random(state) % 1000);
+                std::snprintf(buffer, sizeof(buffer), "%s[%.15f,%.15f]", (point != 0) ? "," : "", x, y);
+                result += buffer;
+            }
+            result += ']';
+        }
+        result += "]}}";
+    }
+    result += "]}";
+    return result;
+}
+
+// citm_catalog.json: big objects keyed by numeric ids, many small integer arrays and nulls.
+static std::string make_citm(std::size_t size, std::size_t& eventCount) {
+    std::uint32_t state = 3;
+    std::string events;
+    std::string performances;
+    std::string areaNames;
+    eventCount = 0;
+    while (events.size() + performances.size() < size) {
+        const std::string id = std::to_string(138586341 + eventCount * 13);
+        events += (eventCount != 0) ? "," : "";
+        events += "\"" + id + R"(":{"description":null,"id":)" + id + R"(,"logo":null,"name":"30th Anniversary Tour )" + std::to_string(eventCount) +
+            R"(","subTopicIds":[337184269,337184283],"subjectCode":null,"subtitle":null,"topicIds":[324846099,107888604]})";
+        performances += (eventCount != 0) ? "," : "";
+        performances += R"({"eventId":)" + id + R"(,"id":)" + std::to_string(339887544 + eventCount) + R"(,"logo":null,"name":null,"prices":[)";
+        for (int price = 0; price < 3; ++price)
+            performances += std::string((price != 0) ? "," : "") + R"({"amount":)" + std::to_string(next_random(state) % 100000) + R"(,"audienceSubCategoryId":337100890,"seatCategoryId":338937295})";
+        performances += R"(],"seatCategories":[{"areas":[{"areaId":205705999,"blockIds":[]},{"areaId":205705998,"blockIds":[]}],"seatCategoryId":338937295}],)"
+            R"("seatMapImage":null,"start":1372701600000,"venueCode":"PLEYEL_PLEYEL"})";
+        if (eventCount < 64)
+            areaNames += std::string((eventCount != 0) ? "," : "") + "\"" + std::to_string(205705993 + eventCount) + R"(":"Arri\u00e8re-sc\u00e8ne central")";
+        ++eventCount;
+    }
+    return R"({"areaNames":{)" + areaNames + R"(},"events":{)" + events + R"(},"performances":[)" + performances + "]}";
+}
+
+// nesting: objects and arrays alternating down to depth, repeated.
+static std::string make_deep(std::size_t size, std::size_t depth) {
+    std::string one;
+    for (std::size_t i = 0; i < depth; ++i)
+        one += (i % 2 == 0) ? R"({"a":)" : "[";
+    one += "0";
+    for (std::size_t i = depth; i != 0; --i)
+        one += ((i - 1) % 2 == 0) ? "}" : "]";
+    std::string result = R"({"deep":[)";
+    while (result.size() < size)
+        result += one + ",";
+    result += one + "]}";
+    return result;
+}
+
+// one huge array of strings, with escapes and non-ASCII text.
+static std::string make_strings(std::size_t size) {
+    static const char* const words[] = {"lorem", "ipsum", "\\\"quoted\\\"", "caf\\u00e9", "na\xC3\xAFve", "tab\\tseparated", "back\\\\slash", "\xE6\x9D\xB1\xE4\xBA\xAC"};
+    std::uint32_t state = 4;
+    std::string result = R"({"strings":[)";
+    for (std::size_t i = 0; result.size() < size; ++i) {
+        result += (i != 0) ? ",\"" : "\"";
+        for (std::uint32_t w = next_random(state) % 24; w != 0; --w)
+            result += std::string(words[next_random(state) % 8]) + ' ';
+        result += '"';
+    }
+    result += "]}";
+    return result;
+}
+
+// one huge array of numbers: integers, decimals and exponents.
+static std::string make_number_array(std::size_t size) {
+    std::uint32_t state = 5;
+    std::string result = R"({"numbers":[)";
+    char buffer[64];
+    for (std::size_t i = 0; result.size() < size; ++i) {
+        const std::uint32_t r = next_random(state);
+        switch (r % 4) {
+        case 0: std::snprintf(buffer, sizeof(buffer), "%u", r); break;
+        case 1: std::snprintf(buffer, sizeof(buffer), "-%u", r % 1000); break;
+        case 2: std::snprintf(buffer, sizeof(buffer), "%.17g", r / 65536.0); break;
+        default: std::snprintf(buffer, sizeof(buffer), "%.6e", r * 1e-12); break;
+        }
+        result += (i != 0) ? "," : "";
+        result += buffer;
+    }
+    result += "]}";
+    return result;
+}
+
+// the same scalar paths as default_json_traits<char>, as any user traits.
+struct custom_traits : jujson::default_json_traits<char> {};
+
+// lookups of the usual kind on each corpus, the result only keeps the work from being optimized away.
+static std::size_t find_in(const std::string& name, const jujson::json_value<std::string>& root, std::size_t eventCount) {
+    std::size_t result = 0;
+    if (name == "twitter") {
+        for (const auto& status : root.find("statuses")->value().get_childs()) {
+            result += status.find("user")->value().find("screen_name")->value().data().size();
+            result += status.find("entities")->value().find("hashtags")->value().get_childs().size();
+        }
+    } else if (name == "canada") {
+        for (const auto& feature : root.find("features")->value().get_childs()) {
+            for (const auto& ring : feature.find("geometry")->value().find("coordinates")->value().get_childs())
+                result += ring.get_childs().size();
+        }
+    } else if (name == "citm_catalog") {
+        const auto& events = root.find("events")->value();
+        for (const auto& performance : root.find("performances")->value().get_childs()) {
+            const auto eventKV = events.find(performance.find("eventId")->value().data());
+            result += (eventKV != events.get_childs().end()) ? eventKV->value().find("name")->value().data().size() : 0;
+        }
+        result += (eventCount == events.get_childs().size());
+    } else if (name == "deep") {
+        for (const auto& nested : root.find("deep")->value().get_childs()) {
+            const jujson::json_value<std::string>* value = &nested;
+            for (;;) {
+                if (value->kind() == jujson::JUSJON_JSON_VALUE_OBJECT) {
+                    const auto aKV = value->find("a");
+                    if (aKV == value->get_childs().end())
+                        break;
+                    value = &aKV->value();
+                } else if ((value->kind() == jujson::JUSJON_JSON_VALUE_ARRAY) && !value->get_childs().empty()) {
+                    value = &value->get_childs().front();
+                } else {
+                    break;
+                }
+                ++result;
+            }
+        }
+    } else if (name == "strings") {
+        for (const auto& str : root.find("strings")->value().get_childs())
+            result += str.data().size();
+    } else {
+        for (const auto& number : root.find("numbers")->value().get_childs())
+            result += static_cast<std::size_t>(number.is_integer());
+    }
+    return result;
+}
+
+template<class StringT_, class TraitsT_>
+static void parse_corpus(const std::string& label, const StringT_& text, std::size_t bytes, std::size_t repeats) {
+    jujson::json_value<StringT_, TraitsT_> value;
+    const measurement result = measure([&]() {
+        for (std::size_t i = 0; i < repeats; ++i)
+            value = jujson::json_parser<StringT_, TraitsT_>(text).parse_json_object_expected();
+    });
+    if (!value.is_valid())
+        info() << label << ": invalid\n";
+    report(label.c_str(), result, bytes * repeats, repeats);
+}
+
+// validation only: the handler ignores what is found, so this is the speed of the scanning loops.
+template<class StringT_, class TraitsT_>
+static void scan_corpus(const std::string& label, const StringT_& text, std::size_t bytes, std::size_t repeats) {
+    bool valid = true;
+    const measurement result = measure([&]() {
+        for (std::size_t i = 0; i < repeats; ++i) {
+            jujson::json_handler<typename StringT_::const_iterator> handler;
+            valid = jujson::json_parser<StringT_, TraitsT_>(text).parse(handler) && valid;
+        }
+    });
+    if (!valid)
+        info() << label << ": invalid\n";
+    report(label.c_str(), result, bytes * repeats, repeats);
+}
+
+// the corpora suite: parse as tree and tape, scan, find and to_string with char, wchar_t and custom traits.
+static bool run_corpora(std::size_t megabytes) {
+    const std::size_t budget = megabytes * 1024 * 1024 / 16; // bytes processed per benchmark
+    std::size_t eventCount = 0;
+    std::vector<corpus> corpora;
+    corpora.push_back(corpus{"twitter", make_twitter(630 * 1024)});
+    corpora.push_back(corpus{"canada", make_canada(2200 * 1024)});
+    corpora.push_back(corpus{"citm_catalog", make_citm(1700 * 1024, eventCount)});
+    corpora.push_back(corpus{"deep", make_deep(1024 * 1024, 256)});
+    corpora.push_back(corpus{"strings", make_strings(2048 * 1024)});
+    corpora.push_back(corpus{"numbers", make_number_array(2048 * 1024)});
+    bool result = true;
+    for (const auto& c : corpora) {
+        const std::string name = c.name;
+        const std::size_t repeats = std::max<std::size_t>(1, budget / c.text.size());
+        info() << name << ": " << c.text.size() / 1024 << " KB, " << repeats << " documents\n";
+        parse_corpus<std::string, jujson::default_json_traits<char>>(name + " parse", c.text, c.text.size(), repeats);
+        jujson::json_tape<std::string> tape;
+        report((name + " parse tape").c_str(), measure([&]() {
+            for (std::size_t i = 0; i < repeats; ++i)
+                tape = jujson::json_parser<std::string>(c.text).parse_json_tape_expected();
+        }), c.text.size() * repeats, repeats);
+        jujson::json_parser_options validating;
+        validating.validateEncoding = true;
+        bool validated = true;
+        report((name + " parse tape, validated encoding").c_str(), measure([&]() {
+            for (std::size_t i = 0; i < repeats; ++i) {
+                jujson::json_parser<std::string> parser(c.text);
+                parser.set_options(validating);
+                tape = parser.parse_json_tape_expected();
+                validated = validated && tape.is_valid();
+            }
+        }), c.text.size() * repeats, repeats);
+        parse_corpus<std::string, custom_traits>(name + " parse custom traits", c.text, c.text.size(), repeats);
+        const std::wstring wide(c.text.begin(), c.text.end()); // bytes widened, the same structure
+        parse_corpus<std::wstring, jujson::default_json_traits<wchar_t>>(name + " parse wchar_t", wide, c.text.size(), repeats);
+        scan_corpus<std::string, jujson::default_json_traits<char>>(name + " scan", c.text, c.text.size(), repeats);
+        scan_corpus<std::string, custom_traits>(name + " scan custom traits", c.text, c.text.size(), repeats);
+        scan_corpus<std::wstring, jujson::default_json_traits<wchar_t>>(name + " scan wchar_t", wide, c.text.size(), repeats);
+
+        const jujson::json_value<std::string> tree = jujson::json_parser<std::string>(c.text).parse_json_object_expected();
+        std::size_t found = 0;
+        report((name + " find").c_str(), measure([&]() {
+            for (std::size_t i = 0; i < repeats; ++i)
+                found += find_in(name, tree, eventCount);
+        }), c.text.size() * repeats, repeats);
+        std::size_t decodedSize = 0;
+        report((name + " decoded strings").c_str(), measure([&]() {
+            for (std::size_t i = 0; i < repeats; ++i)
+                decodedSize = decode_strings(tree);
+        }), c.text.size() * repeats, repeats);
+        std::string text;
+        report((name + " to_string").c_str(), measure([&]() {
+            for (std::size_t i = 0; i < repeats; ++i)
+                text = tree.to_string();
+        }), c.text.size() * repeats, repeats);
+        info() << name << " found: " << found << ", decoded strings: " << decodedSize / 1024 << " KB\n";
+        result = result && validated && tree.is_valid() && (found != 0) && (jujson::json_parser<std::string>(text).parse_json_object_expected().to_string() == text);
+    }
+    return result;
+}
+
+int main(int argc, char** argv) {
+    // arguments in any order: megabytes of each generated document, --json, --corpora for the corpora suite only.
+    std::size_t megabytes = 100;
+    bool corporaOnly = false;
+    for (int i = 1; i < argc; ++i) {
+        const std::string argument = argv[i];
+        if (argument == "--json")
+            jsonOutput = true;
+        else if (argument == "--corpora")
+            corporaOnly = true;
+        else
+            megabytes = std::strtoul(argv[i], nullptr, 10);
+    }
+    const bool corpora = run_corpora(megabytes);
+    if (corporaOnly)
+        return corpora ? 0 : 1;
+
+    const std::string data = make_document(megabytes * 1024 * 1024);
+    info() << "document: " << data.size() / (1024.0 * 1024.0) << " MB\n";
+
+    jujson::json_value<std::string> tree;
+    jujson::json_tape<std::string> tape;
+    report("tree parse", measure([&]() { tree = jujson::json_parser<std::string>(data).parse_json_object_expected(); }), data.size());
+    report("tape parse", measure([&]() { tape = jujson::json_parser<std::string>(data).parse_json_tape_expected(); }), data.size());
+    jujson::json_value<std::string> eagerTree;
+    report("tree parse, eager positions", measure([&]() {
+        eagerTree = jujson::json_parser<std::string, jujson::default_json_traits<char>, std::allocator<char>, jujson::json_eager_position>(data).parse_json_object_expected();
+    }), data.size());
+    eagerTree = jujson::json_value<std::string>();
+
+    std::size_t treeCount = 0;
+    std::size_t tapeCount = 0;
+    report("tree iteration", measure([&]() { treeCount = iterate_tree(tree); }), data.size());
+    report("tape iteration", measure([&]() { tapeCount = iterate_tape(tape); }), data.size());
+    info() << "team members: " << treeCount << ' ' << tapeCount << '\n';
+
+    // compact tree: 16-byte nodes with short strings inline, against the tree of json_value above.
+    jujson::json_compact_tree<std::string> compactTree;
+    report("compact tree parse", measure([&]() { compactTree = jujson::json_parser<std::string>(data).parse_json_compact_expected(); }), data.size());
+    std::size_t compactCount = 0;
+    report("compact tree iteration", measure([&]() { compactCount = iterate_tree(compactTree.root()); }), data.size());
+    info() << "compact nodes: " << compactTree.nodes().size() << " of " << sizeof(jujson::json_compact_node<char>) << " bytes, json_value is " << sizeof(jujson::json_value<std::string>) << " bytes\n";
+    compactTree = jujson::json_compact_tree<std::string>();
+
+    // nesting: a million levels parsed without a depth limit, the engine keeps open containers on its own stack.
+    const std::string deep = "{\"a\":" + std::string(1024 * 1024, '[') + std::string(1024 * 1024, ']') + "}";
+    jujson::json_parser_options deepOptions;
+    deepOptions.maxDepth = 0;
+    std::size_t deepNodes = 0;
+    report("deeply nested tape parse", measure([&]() {
+        jujson::json_parser<std::string> parser(deep);
+        parser.set_options(deepOptions);
+        deepNodes = parser.parse_json_tape_expected().nodes().size();
+    }), deep.size());
+
+    // lazy tree: nested containers are validated while parsing and built on first access.
+    jujson::json_parser_options lazyOptions;
+    lazyOptions.lazy = true;
+    jujson::json_value<std::string> lazyTree;
+    const auto parseLazy = [&]() {
+        jujson::json_parser<std::string> parser(data);
+        parser.set_options(lazyOptions);
+        lazyTree = parser.parse_json_object_expected();
+    };
+    report("lazy tree parse", measure(parseLazy), data.size());
+    std::string firstName;
+    report("lazy tree first record name", measure([&]() {
+        firstName = lazyTree.find("records")->value().get_childs().front().find("name")->value().data();
+    }), data.size());
+    std::size_t lazyCount = 0;
+    report("lazy tree iteration", measure([&]() { lazyCount = iterate_tree(lazyTree); }), data.size());
+    lazyTree = jujson::json_value<std::string>();
+    report("lazy tree parse and first record name", measure([&]() {
+        parseLazy();
+        firstName = lazyTree.find("records")->value().get_childs().front().find("name")->value().data();
+    }), data.size());
+    lazyTree = jujson::json_value<std::string>();
+    info() << "lazy team members: " << lazyCount << ' ' << firstName << '\n';
+
+    std::string serialized;
+    report("tree to_string", measure([&]() { serialized = tree.to_string(); }), data.size());
+    std::string reserved;
+    report("tree writer, reserved string", measure([&]() {
+        typedef jujson::json_string_sink<std::string> sink_type;
+        reserved.clear();
+        reserved.reserve(jujson::json_writer<sink_type>::size(tree));
+        sink_type sink(reserved);
+        jujson::json_writer<sink_type>(sink).write(tree);
+    }), data.size());
+    std::string buffered;
+    report("tree writer, 64 KB buffer", measure([&]() {
+        auto flush = [&](const char* b, std::size_t size) { buffered.append(b, size); };
+        jujson::json_buffer_sink<char, decltype(flush)> sink(flush);
+        jujson::json_writer<decltype(sink)>(sink).write(tree);
+    }), data.size());
+    const bool roundTrip = (serialized == data) && (reserved == data) && (buffered == data);
+
+    // cached serialization: unchanged subtrees are copied as text, each JSON Patch changes one record before writing again.
+    std::string cached;
+    report("tree to_string_cached, first", measure([&]() { cached = tree.to_string_cached(); }), data.size());
+    report("tree to_string_cached, unchanged", measure([&]() { cached = tree.to_string_cached(); }), data.size());
+    const std::size_t recordCount = static_cast<const jujson::json_value<std::string>&>(tree).find("records")->value().get_childs().size();
+    std::vector<jujson::json_value<std::string>> patches;
+    for (std::size_t i = 0; i < 10; ++i) {
+        const std::string operations = R"([{"op":"replace","path":"/records/)" + std::to_string(i * recordCount / 10) + R"(/age","value":)" + std::to_string(40 + i) + "}]";
+        jujson::json_parser<std::string> parser(operations);
+        jujson::json_value_builder<jujson::json_value<std::string>> builder;
+        parser.parse(builder);
+        patches.push_back(builder.release());
+    }
+    bool patched = true;
+    report("tree patched and to_string_cached", measure([&]() {
+        for (const auto& patch : patches) {
+            patched = patched && (jujson::apply_json_patch(tree, patch) == jujson::JUJSON_ERROR_CODE_SUCCESS);
+            cached = tree.to_string_cached();
+        }
+    }), data.size() * patches.size(), patches.size());
+    const bool cachedRoundTrip = patched && (cached == tree.to_string()) && (cached != data);
+
+    // the document from a file: read into a std::string, then mapped and parsed in place.
+    const char* path = "jujson_bench.json";
+    {
+        std::ofstream file(path, std::ios::binary);
+        file << data;
+    }
+    std::size_t fileSize = 0;
+    tree = jujson::json_value<std::string>();
+    report("file read into string and parse", measure([&]() {
+        std::ifstream file(path, std::ios::binary);
+        const std::string contents((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+        fileSize = contents.size();
+        tree = jujson::json_parser<std::string>(contents).parse_json_object_expected();
+    }), data.size());
+#if (JUJSON_HAS_STRING_VIEW)
+    std::size_t mappedSize = 0;
+    {
+        jujson::json_mapped_file mapped;
+        jujson::json_value<std::string_view> viewTree;
+        report("file mapped and parse", measure([&]() {
+            mapped.open(path);
+            mappedSize = mapped.size();
+            viewTree = jujson::json_parser<std::string_view>(mapped.view()).parse_json_object_expected();
+        }), data.size());
+        jujson::json_tape<std::string_view> viewTape;
+        report("file mapped and tape parse", measure([&]() {
+            mapped.open(path);
+            viewTape = jujson::json_parser<std::string_view>(mapped.view()).parse_json_tape_expected();
+        }), data.size());
+    }
+#else
+    const std::size_t mappedSize = fileSize;
+#endif
+    std::remove(path);
+
+    // the tree as a binary snapshot: encoded, decoded back to a tree, then a mapped snapshot validated and read in place.
+    std::string snapshot;
+    report("binary encode", measure([&]() { snapshot = jujson::encode_json_binary(tree); }), data.size());
+    info() << "snapshot: " << snapshot.size() / (1024.0 * 1024.0) << " MB\n";
+    jujson::json_value<std::string> decoded;
+    tree = jujson::json_value<std::string>();
+    report("binary decode to tree", measure([&]() { decoded = jujson::decode_json_binary<jujson::json_value<std::string>>(snapshot.data(), snapshot.size()); }), data.size());
+    const bool snapshotRoundTrip = decoded.to_string() == data;
+    decoded = jujson::json_value<std::string>();
+#if (JUJSON_HAS_STRING_VIEW)
+    const char* snapshotPath = "jujson_bench.jujb";
+    {
+        std::ofstream file(snapshotPath, std::ios::binary);
+        file << snapshot;
+    }
+    std::size_t snapshotCount = 0;
+    {
+        jujson::json_mapped_file mapped;
+        jujson::json_binary_view<std::string_view, jujson::default_json_traits<char>> view;
+        report("binary file mapped and opened", measure([&]() {
+            mapped.open(snapshotPath);
+            view.open(mapped.data(), mapped.size());
+        }), data.size());
+        report("binary view first record name", measure([&]() {
+            firstName = std::string(view.root().find("records")->value().get_childs().begin()->find("name")->value().data());
+        }), data.size());
+        report("binary view iteration", measure([&]() {
+            snapshotCount = 0;
+            for (const auto& record : view.root().find("records")->value().get_childs())
+                for (const auto& item : record.find("projects")->value().get_childs())
+                    snapshotCount += item.find("team")->value().size();
+        }), data.size());
+    }
+    std::remove(snapshotPath);
+    info() << "snapshot team members: " << snapshotCount << ' ' << firstName << '\n';
+#else
+    const std::size_t snapshotCount = treeCount;
+#endif
+
+#if (JUJSON_HAS_MEMORY_RESOURCE)
+    // arena documents: strings owned by the nodes, views of the input, then views of keys and short strings interned in the arena.
+    std::size_t documentCount = 0;
+    {
+        jujson::json_document<std::pmr::string> stringDocument(1024 * 1024);
+        report("document, pmr strings", measure([&]() { stringDocument.parse_json_object_expected(std::pmr::string(data)); }), data.size());
+        documentCount += iterate_tree(stringDocument.root());
+    }
+    {
+        jujson::json_document<std::string_view> viewDocument(1024 * 1024);
+        report("document, views of the input", measure([&]() { viewDocument.parse_json_object_expected(data); }), data.size());
+        documentCount += iterate_tree(viewDocument.root());
+    }
+    {
+        jujson::json_document<std::string_view> internDocument(1024 * 1024);
+        jujson::json_parser_options internOptions;
+        internOptions.internLength = 16;
+        internDocument.set_options(internOptions);
+        internDocument.set_interning(true);
+        report("document, interned views", measure([&]() { internDocument.parse_json_object_expected(data); }), data.size());
+        documentCount += iterate_tree(internDocument.root());
+        info() << "interned strings: " << internDocument.interned_count() << '\n';
+    }
+#else
+    const std::size_t documentCount = treeCount * 3;
+#endif
+
+    // newline-delimited records: a parser per line on one thread, then the batch parser with more and more threads.
+    const std::string lines = make_lines(megabytes * 1024 * 1024);
+    std::vector<jujson::json_value<std::string>> lineValues;
+    report("ndjson line by line", measure([&]() {
+        for (std::size_t b = 0, e = 0; b < lines.size(); b = e + 1) {
+            e = lines.find('\n', b);
+            if (e == std::string::npos)
+                e = lines.size();
+            lineValues.push_back(jujson::json_parser<std::string>(lines.begin() + b, lines.begin() + e).parse_json_object_expected());
+        }
+    }), lines.size());
+    const std::size_t lineCount = lineValues.size();
+    lineValues.clear();
+
+    // request loop: each line is a message parsed then dropped, by a new tree per message or by one document that keeps its arena.
+    std::size_t messageCount = 0;
+    report("messages, a tree each", measure([&]() {
+        messageCount += parse_messages(lines, [](std::string::const_iterator b, std::string::const_iterator e) {
+            return jujson::json_parser<std::string>(b, e).parse_json_object_expected().is_valid();
+        });
+    }), lines.size());
+#if (JUJSON_HAS_MEMORY_RESOURCE)
+    {
+        jujson::json_document<std::string_view> messageDocument(16 * 1024);
+        messageDocument.parse_json_object_expected(lines.substr(0, lines.find('\n'))); // warm up
+        report("messages, one reused document", measure([&]() {
+            messageCount += parse_messages(lines, [&](std::string::const_iterator b, std::string::const_iterator e) {
+                return messageDocument.parse_json_object_expected(std::string_view(&*b, static_cast<std::size_t>(e - b))).is_valid();
+            });
+        }), lines.size());
+        info() << "document arena: " << messageDocument.capacity() / 1024.0 << " KB\n";
+    }
+#else
+    messageCount *= 2;
+#endif
+    const unsigned hardwareThreads = std::max(1u, std::thread::hardware_concurrency());
+    std::size_t batchCount = 0;
+    for (unsigned threads = 1; ; threads = std::min(threads * 2, hardwareThreads)) {
+        const std::string name = "ndjson batch, " + std::to_string(threads) + " threads";
+        jujson::json_batch_parser<std::string>::container_type records;
+        report(name.c_str(), measure([&]() { records = jujson::json_batch_parser<std::string>(lines).parse(threads); }), lines.size());
+        batchCount = records.size();
+        if (threads == hardwareThreads)
+            break;
+    }
+    info() << "records: " << lineCount << ' ' << batchCount << '\n';
+
+    // every line into a struct: through json_value and copied by hand, then bound directly.
+    std::vector<bench::person> people;
+    people.reserve(lineCount);
+    report("ndjson into structs through json_value", measure([&]() {
+        for (std::size_t b = 0, e = 0; b < lines.size(); b = e + 1) {
+            e = lines.find('\n', b);
+            if (e == std::string::npos)
+                e = lines.size();
+            const auto value = jujson::json_parser<std::string>(lines.begin() + b, lines.begin() + e).parse_json_object_expected();
+            bench::person person;
+            for (const auto& kv : value.get_childs()) {
+                const std::string& key = kv.data();
+                const auto& field = kv.value();
+                if (key == "name") {
+                    person.name = field.decoded_data();
+                } else if (key == "age") {
+                    person.age = static_cast<int>(field.as_int64());
+                } else if (key == "isEmployed") {
+                    person.isEmployed = (field.kind() == jujson::JUSJON_JSON_VALUE_TRUE);
+                } else if (key == "address") {
+                    person.address.street = field.find("street")->value().decoded_data();
+                    person.address.city = field.find("city")->value().decoded_data();
+                    person.address.state = field.find("state")->value().decoded_data();
+                    person.address.postalCode = field.find("postalCode")->value().decoded_data();
+                } else if (key == "salary") {
+                    person.salary = field.as_double();
+                } else if (key == "children") {
+                    for (const auto& child : field.get_childs())
+                        person.children.push_back(child.decoded_data());
+                } else if (key == "phoneNumbers") {
+                    for (const auto& phone : field.get_childs())
+                        person.phoneNumbers.push_back(bench::phone_number{phone.find("type")->value().decoded_data(), phone.find("number")->value().decoded_data()});
+                } else if (key == "projects") {
+                    for (const auto& item : field.get_childs()) {
+                        bench::project project;
+                        project.name = item.find("name")->value().decoded_data();
+                        project.status = item.find("status")->value().decoded_data();
+                        for (const auto& member : item.find("team")->value().get_childs())
+                            project.team.push_back(member.decoded_data());
+                        person.projects.push_back(JUJSON_MOVE(project));
+                    }
+                }
+            }
+            people.push_back(JUJSON_MOVE(person));
+        }
+    }), lines.size());
+    const std::size_t copiedCount = people.size();
+    const std::string copiedText = jujson::bound_to_string<std::string>(people.back());
+    people.clear();
+    report("ndjson into structs by binding", measure([&]() {
+        for (std::size_t b = 0, e = 0; b < lines.size(); b = e + 1) {
+            e = lines.find('\n', b);
+            if (e == std::string::npos)
+                e = lines.size();
+            people.emplace_back();
+            jujson::json_parser<std::string>(lines.begin() + b, lines.begin() + e).parse_into(people.back());
+        }
+    }), lines.size());
+    std::string boundText;
+    report("structs written", measure([&]() {
+        for (const auto& person : people)
+            boundText = jujson::bound_to_string<std::string>(person);
+    }), lines.size());
+    info() << "structs: " << copiedCount << ' ' << people.size() << '\n';
+    const bool bound = (copiedCount == people.size()) && (copiedText == boundText);
+    people = std::vector<bench::person>();
+
+    // a few fields of every line: parsed and looked up, then selected by a query while scanning.
+    std::size_t lookupCount = 0;
+    report("ndjson fields by parse and find", measure([&]() {
+        for (std::size_t b = 0, e = 0; b < lines.size(); b = e + 1) {
+            e = lines.find('\n', b);
+            if (e == std::string::npos)
+                e = lines.size();
+            const auto value = jujson::json_parser<std::string>(lines.begin() + b, lines.begin() + e).parse_json_object_expected();
+            lookupCount += (value.find("name") != value.get_childs().end()) + (value.find("salary") != value.get_childs().end());
+            auto addressKV = value.find("address");
+            lookupCount += (addressKV != value.get_childs().end()) && (addressKV->value().find("city") != addressKV->value().get_childs().end());
+        }
+    }), lines.size());
+    const jujson::json_query<std::string> fieldsQuery = {"/name", "/salary", "/address/city"};
+    std::size_t queryCount = 0;
+    report("ndjson fields by query", measure([&]() {
+        for (std::size_t b = 0, e = 0; b < lines.size(); b = e + 1) {
+            e = lines.find('\n', b);
+            if (e == std::string::npos)
+                e = lines.size();
+            jujson::json_parser<std::string> parser(lines.begin() + b, lines.begin() + e);
+            fieldsQuery.select(parser, [&](std::size_t, const jujson::json_value<std::string>&) { ++queryCount; return true; });
+        }
+    }), lines.size());
+    info() << "fields: " << lookupCount << ' ' << queryCount << '\n';
+
+    // one top-level array of records: sequential parsing, then elements parsed concurrently.
+    const std::string array = data.substr(data.find('['), data.size() - data.find('[') - 1);
+    std::size_t sequentialCount = 0;
+    report("array sequential", measure([&]() {
+        jujson::json_parser<std::string> parser(array);
+        jujson::json_value_builder<jujson::json_value<std::string>> builder;
+        parser.parse(builder);
+        sequentialCount = builder.release().get_childs().size();
+    }), array.size());
+    std::size_t parallelCount = 0;
+    for (unsigned threads = 1; ; threads = std::min(threads * 2, hardwareThreads)) {
+        const std::string name = "array parallel, " + std::to_string(threads) + " threads";
+        report(name.c_str(), measure([&]() { parallelCount = jujson::json_parser<std::string>(array).parse_json_array_parallel(threads).get_childs().size(); }), array.size());
+        if (threads == hardwareThreads)
+            break;
+    }
+    info() << "elements: " << sequentialCount << ' ' << parallelCount << '\n';
+
+    // numbers: text converted by the reader, decoded while parsing, decoded without keeping the text.
+    const std::string numbers = make_numbers(megabytes * 1024 * 1024);
+    jujson::json_value<std::string> numbersTree;
+    report("numbers parse", measure([&]() { numbersTree = jujson::json_parser<std::string>(numbers).parse_json_object_expected(); }), numbers.size());
+    double textSum = 0.0;
+    double decodedSum = 0.0;
+    report("numbers read with stod", measure([&]() {
+        for (const auto& sample : numbersTree.find("samples")->value().get_childs()) {
+            for (const auto& kv : sample.get_childs())
+                textSum += (kv.value().kind() == jujson::JUSJON_JSON_VALUE_NUMBER) ? std::stod(kv.value().data()) : 0.0;
+        }
+    }), numbers.size());
+    report("numbers read decoded", measure([&]() {
+        for (const auto& sample : numbersTree.find("samples")->value().get_childs()) {
+            for (const auto& kv : sample.get_childs())
+                decodedSum += kv.value().as_double();
+        }
+    }), numbers.size());
+    jujson::json_parser_options options;
+    options.numberText = false;
+    numbersTree = jujson::json_value<std::string>();
+    report("numbers parse without text", measure([&]() {
+        jujson::json_parser<std::string> parser(numbers);
+        parser.set_options(options);
+        numbersTree = parser.parse_json_object_expected();
+    }), numbers.size());
+    info() << "sums: " << textSum << ' ' << decodedSum << '\n';
+    return (corpora && roundTrip && cachedRoundTrip && bound && (lookupCount == queryCount) && (lazyCount == treeCount) && (fileSize == mappedSize) && (treeCount == tapeCount) && (compactCount == treeCount) && (deepNodes == 1024 * 1024 + 2) && (lineCount == batchCount) && (messageCount == lineCount * 2) && (sequentialCount == parallelCount) && (textSum == decodedSum) && snapshotRoundTrip && (snapshotCount == treeCount) && (documentCount == treeCount * 3)) ? 0 : 1;
+}
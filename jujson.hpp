@@ -43,9 +43,18 @@
 #   define JUJSON_SIZE_TYPE ::std::size_t
 #endif
 
+#if (!(defined JUJSON_KEY_INDEX_THRESHOLD))
+#   define JUJSON_KEY_INDEX_THRESHOLD 16 // objects with less keys are searched linearly
+#endif
+
+#if (!(defined JUJSON_CACHED_TEXT_MIN_SIZE))
+#   define JUJSON_CACHED_TEXT_MIN_SIZE 256 // shorter arrays and objects are written again by json_value::to_string_cached
+#endif
+
 #if (!(defined JUJSON_IS_SPACE))
 #   include <cctype>
 #   define JUJSON_IS_SPACE(c__) (::std::isspace(c__))
+#   define JUJSON_DEFAULT_IS_SPACE_ 1
 #endif
 
 #if (!(defined JUJSON_IS_ALPHA))
@@ -56,6 +65,7 @@
 #if (!(defined JUJSON_IS_DIGIT))
 #   include <cctype>
 #   define JUJSON_IS_DIGIT(c__) (::std::isdigit(c__))
+#   define JUJSON_DEFAULT_IS_DIGIT_ 1
 #endif
 
 #if (!(defined JUJSON_ASSERT))
@@ -63,7 +73,143 @@
 #   define JUJSON_ASSERT(expr__) assert(expr__)
 #endif
 
+#if (!(defined JUJSON_HAS_STRING_VIEW))
+#   if (((defined __cplusplus) && (__cplusplus >= 201703L)) || ((defined _MSVC_LANG) && (_MSVC_LANG >= 201703L)))
+#       define JUJSON_HAS_STRING_VIEW 1
+#   else
+#       define JUJSON_HAS_STRING_VIEW 0
+#   endif
+#endif
+
+#if (JUJSON_HAS_STRING_VIEW)
+#   include <string_view>
+#endif
+
+#if (!(defined JUJSON_HAS_MEMORY_RESOURCE))
+#   if (JUJSON_HAS_STRING_VIEW) && (defined __has_include)
+#       if __has_include(<memory_resource>)
+#           define JUJSON_HAS_MEMORY_RESOURCE 1
+#       else
+#           define JUJSON_HAS_MEMORY_RESOURCE 0
+#       endif
+#   else
+#       define JUJSON_HAS_MEMORY_RESOURCE 0
+#   endif
+#endif
+
+#if (JUJSON_HAS_MEMORY_RESOURCE)
+#   include <memory_resource>
+#endif
+
+#if (!(defined JUJSON_HAS_FROM_CHARS)) // floating point from_chars and to_chars
+#   if (JUJSON_HAS_STRING_VIEW) && (defined __has_include)
+#       if __has_include(<charconv>)
+#           include <charconv>
+#       endif
+#   endif
+#   if (defined __cpp_lib_to_chars) && (__cpp_lib_to_chars >= 201611L)
+#       define JUJSON_HAS_FROM_CHARS 1
+#   else
+#       define JUJSON_HAS_FROM_CHARS 0
+#   endif
+#endif
+
+#if (JUJSON_HAS_FROM_CHARS)
+#   include <charconv>
+#   include <system_error>
+#endif
+
+// Vectorized scanning of char input with default traits, define JUJSON_NO_SIMD to always use the scalar loops.
+#if (!(defined JUJSON_NO_SIMD)) && ((defined __SSE2__) || (defined _M_X64) || ((defined _M_IX86_FP) && (_M_IX86_FP >= 2)))
+#   include <emmintrin.h>
+#   define JUJSON_HAS_SSE2 1
+#   if ((defined __GNUC__) || (defined __clang__)) && ((defined __x86_64__) || (defined __i386__))
+#       include <immintrin.h>
+#       define JUJSON_HAS_AVX2_DISPATCH 1 // AVX2 kernels are compiled with target attributes and picked at runtime.
+#   endif
+#endif
+#if (defined _MSC_VER)
+#   include <intrin.h>
+#endif
+
+// Batch parsing runs on std::thread workers, define JUJSON_NO_THREADS to parse batches on the calling thread.
+#if (!(defined JUJSON_NO_THREADS))
+#   include <atomic>
+#   include <exception>
+#   include <thread>
+#endif
+
+// Binding of user structs: JUJSON_BIND(type, members...) in the namespace of the type, up to 32 members, see json_parser::parse_into and json_writer::write_bound.
+#define JUJSON_EXPAND_(x__) x__
+#define JUJSON_BIND_FIELD_(type__, member__) visitor.template field<decltype(&type__::member__), &type__::member__>(#member__);
+#define JUJSON_BIND_EACH_1_(type__, member__) JUJSON_BIND_FIELD_(type__, member__)
+#define JUJSON_BIND_EACH_2_(type__, member__, ...) JUJSON_BIND_FIELD_(type__, member__) JUJSON_EXPAND_(JUJSON_BIND_EACH_1_(type__, __VA_ARGS__))
+#define JUJSON_BIND_EACH_3_(type__, member__, ...) JUJSON_BIND_FIELD_(type__, member__) JUJSON_EXPAND_(JUJSON_BIND_EACH_2_(type__, __VA_ARGS__))
+#define JUJSON_BIND_EACH_4_(type__, member__, ...) JUJSON_BIND_FIELD_(type__, member__) JUJSON_EXPAND_(JUJSON_BIND_EACH_3_(type__, __VA_ARGS__))
+#define JUJSON_BIND_EACH_5_(type__, member__, ...) JUJSON_BIND_FIELD_(type__, member__) JUJSON_EXPAND_(JUJSON_BIND_EACH_4_(type__, __VA_ARGS__))
+#define JUJSON_BIND_EACH_6_(type__, member__, ...) JUJSON_BIND_FIELD_(type__, member__) JUJSON_EXPAND_(JUJSON_BIND_EACH_5_(type__, __VA_ARGS__))
+#define JUJSON_BIND_EACH_7_(type__, member__, ...) JUJSON_BIND_FIELD_(type__, member__) JUJSON_EXPAND_(JUJSON_BIND_EACH_6_(type__, __VA_ARGS__))
+#define JUJSON_BIND_EACH_8_(type__, member__, ...) JUJSON_BIND_FIELD_(type__, member__) JUJSON_EXPAND_(JUJSON_BIND_EACH_7_(type__, __VA_ARGS__))
+#define JUJSON_BIND_EACH_9_(type__, member__, ...) JUJSON_BIND_FIELD_(type__, member__) JUJSON_EXPAND_(JUJSON_BIND_EACH_8_(type__, __VA_ARGS__))
+#define JUJSON_BIND_EACH_10_(type__, member__, ...) JUJSON_BIND_FIELD_(type__, member__) JUJSON_EXPAND_(JUJSON_BIND_EACH_9_(type__, __VA_ARGS__))
+#define JUJSON_BIND_EACH_11_(type__, member__, ...) JUJSON_BIND_FIELD_(type__, member__) JUJSON_EXPAND_(JUJSON_BIND_EACH_10_(type__, __VA_ARGS__))
+#define JUJSON_BIND_EACH_12_(type__, member__, ...) JUJSON_BIND_FIELD_(type__, member__) JUJSON_EXPAND_(JUJSON_BIND_EACH_11_(type__, __VA_ARGS__))
+#define JUJSON_BIND_EACH_13_(type__, member__, ...) JUJSON_BIND_FIELD_(type__, member__) JUJSON_EXPAND_(JUJSON_BIND_EACH_12_(type__, __VA_ARGS__))
+#define JUJSON_BIND_EACH_14_(type__, member__, ...) JUJSON_BIND_FIELD_(type__, member__) JUJSON_EXPAND_(JUJSON_BIND_EACH_13_(type__, __VA_ARGS__))
+#define JUJSON_BIND_EACH_15_(type__, member__, ...) JUJSON_BIND_FIELD_(type__, member__) JUJSON_EXPAND_(JUJSON_BIND_EACH_14_(type__, __VA_ARGS__))
+#define JUJSON_BIND_EACH_16_(type__, member__, ...) JUJSON_BIND_FIELD_(type__, member__) JUJSON_EXPAND_(JUJSON_BIND_EACH_15_(type__, __VA_ARGS__))
+#define JUJSON_BIND_EACH_17_(type__, member__, ...) JUJSON_BIND_FIELD_(type__, member__) JUJSON_EXPAND_(JUJSON_BIND_EACH_16_(type__, __VA_ARGS__))
+#define JUJSON_BIND_EACH_18_(type__, member__, ...) JUJSON_BIND_FIELD_(type__, member__) JUJSON_EXPAND_(JUJSON_BIND_EACH_17_(type__, __VA_ARGS__))
+#define JUJSON_BIND_EACH_19_(type__, member__, ...) JUJSON_BIND_FIELD_(type__, member__) JUJSON_EXPAND_(JUJSON_BIND_EACH_18_(type__, __VA_ARGS__))
+#define JUJSON_BIND_EACH_20_(type__, member__, ...) JUJSON_BIND_FIELD_(type__, member__) JUJSON_EXPAND_(JUJSON_BIND_EACH_19_(type__, __VA_ARGS__))
+#define JUJSON_BIND_EACH_21_(type__, member__, ...) JUJSON_BIND_FIELD_(type__, member__) JUJSON_EXPAND_(JUJSON_BIND_EACH_20_(type__, __VA_ARGS__))
+#define JUJSON_BIND_EACH_22_(type__, member__, ...) JUJSON_BIND_FIELD_(type__, member__) JUJSON_EXPAND_(JUJSON_BIND_EACH_21_(type__, __VA_ARGS__))
+#define JUJSON_BIND_EACH_23_(type__, member__, ...) JUJSON_BIND_FIELD_(type__, member__) JUJSON_EXPAND_(JUJSON_BIND_EACH_22_(type__, __VA_ARGS__))
+#define JUJSON_BIND_EACH_24_(type__, member__, ...) JUJSON_BIND_FIELD_(type__, member__) JUJSON_EXPAND_(JUJSON_BIND_EACH_23_(type__, __VA_ARGS__))
+#define JUJSON_BIND_EACH_25_(type__, member__, ...) JUJSON_BIND_FIELD_(type__, member__) JUJSON_EXPAND_(JUJSON_BIND_EACH_24_(type__, __VA_ARGS__))
+#define JUJSON_BIND_EACH_26_(type__, member__, ...) JUJSON_BIND_FIELD_(type__, member__) JUJSON_EXPAND_(JUJSON_BIND_EACH_25_(type__, __VA_ARGS__))
+#define JUJSON_BIND_EACH_27_(type__, member__, ...) JUJSON_BIND_FIELD_(type__, member__) JUJSON_EXPAND_(JUJSON_BIND_EACH_26_(type__, __VA_ARGS__))
+#define JUJSON_BIND_EACH_28_(type__, member__, ...) JUJSON_BIND_FIELD_(type__, member__) JUJSON_EXPAND_(JUJSON_BIND_EACH_27_(type__, __VA_ARGS__))
+#define JUJSON_BIND_EACH_29_(type__, member__, ...) JUJSON_BIND_FIELD_(type__, member__) JUJSON_EXPAND_(JUJSON_BIND_EACH_28_(type__, __VA_ARGS__))
+#define JUJSON_BIND_EACH_30_(type__, member__, ...) JUJSON_BIND_FIELD_(type__, member__) JUJSON_EXPAND_(JUJSON_BIND_EACH_29_(type__, __VA_ARGS__))
+#define JUJSON_BIND_EACH_31_(type__, member__, ...) JUJSON_BIND_FIELD_(type__, member__) JUJSON_EXPAND_(JUJSON_BIND_EACH_30_(type__, __VA_ARGS__))
+#define JUJSON_BIND_EACH_32_(type__, member__, ...) JUJSON_BIND_FIELD_(type__, member__) JUJSON_EXPAND_(JUJSON_BIND_EACH_31_(type__, __VA_ARGS__))
+#define JUJSON_BIND_COUNT_(_1, _2, _3, _4, _5, _6, _7, _8, _9, _10, _11, _12, _13, _14, _15, _16, _17, _18, _19, _20, _21, _22, _23, _24, _25, _26, _27, _28, _29, _30, _31, _32, count__, ...) count__
+#define JUJSON_BIND_EACH_(count__) JUJSON_BIND_EACH_##count__##_
+#define JUJSON_BIND_SELECT_(count__) JUJSON_BIND_EACH_(count__)
+#define JUJSON_BIND(type__, ...) \
+    template<class VisitorT_> inline void jujson_bind_fields(const type__*, VisitorT_& visitor) { \
+        JUJSON_EXPAND_(JUJSON_BIND_SELECT_(JUJSON_EXPAND_(JUJSON_BIND_COUNT_(__VA_ARGS__, 32, 31, 30, 29, 28, 27, 26, 25, 24, 23, 22, 21, 20, 19, 18, 17, 16, 15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1)))(type__, __VA_ARGS__)) \
+    }
+
+// Files are memory-mapped on POSIX systems, define JUJSON_NO_MMAP to always read them into a buffer.
+#if (!(defined JUJSON_NO_MMAP)) && ((defined __unix__) || (defined __APPLE__))
+#   include <fcntl.h>
+#   include <sys/mman.h>
+#   include <sys/stat.h>
+#   include <unistd.h>
+#   include <cerrno>
+#   define JUJSON_HAS_MMAP 1
+#else
+#   define JUJSON_HAS_MMAP 0
+#endif
+
+#include <algorithm>
+#include <clocale>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <initializer_list>
 #include <iostream>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <new>
+#include <string>
+#include <type_traits>
+#include <vector>
 
 namespace jujson {
     enum json_value_kind {
@@ -82,6 +228,13 @@ namespace jujson {
         JUJSON_ERROR_CODE_SUCCESS,
         JUJSON_ERROR_CODE_UNEXPECTED,
         JUJSON_ERROR_CODE_EOF,
+        JUJSON_ERROR_CODE_ABORTED, // stopped by a handler.
+        JUJSON_ERROR_CODE_TYPE_MISMATCH, // a value does not fit the bound member, see json_parser::parse_into.
+        JUJSON_ERROR_CODE_INVALID_BINARY, // not a valid snapshot of encode_json_binary, see json_binary_view::open.
+        JUJSON_ERROR_CODE_DEPTH, // arrays and objects nested deeper than json_parser_options::maxDepth.
+        JUJSON_ERROR_CODE_INVALID_ENCODING, // a string litteral that is not valid UTF-8, UTF-16 or UTF-32, see json_parser_options::validateEncoding.
+        JUJSON_ERROR_CODE_INVALID_PATCH, // a malformed JSON Patch operation, or one whose location does not exist, see apply_json_patch.
+        JUJSON_ERROR_CODE_TEST_FAILED, // a JSON Patch test operation on a different value, see apply_json_patch.
     };
 
     template<class CharT_>
@@ -158,450 +311,6280 @@ namespace jujson {
             return JUSJON_JSON_VALUE_INVALID;}
     };
     /**
-     * @brief Represents a JSON value, which can be a null, boolean, string, number, array, or object.
-     * @tparam StringT_ the type of the string to use.
+     * @brief Classes of code units for the parsers: what a value starting with the code unit is, and the sets scanning loops test.
+     *        The classes of the first 256 code units are computed once from the traits class and JUJSON_IS_SPACE, JUJSON_IS_ALPHA,
+     *        JUJSON_IS_DIGIT into a table, so that a loop does one lookup instead of a chain of predicates. Other code units are classified on each call.
+     *        The macros are given ASCII code units only, as non-negative ints: other code units are never spaces, letters or digits, whatever the locale.
      * @tparam JSONTraitsT_ the traits class used to define JSON-specific characteristics.
      */
-    template <class StringT_, class JSONTraitsT_ = default_json_traits<typename StringT_::value_type>>
-    struct json_value final {
-        private:
-        typedef JSONTraitsT_ json_traits;
+    template<class JSONTraitsT_>
+    struct json_char_classes final {
+        public:
+        typedef typename JSONTraitsT_::char_type char_type;
+        typedef typename ::std::make_unsigned<char_type>::type unsigned_type;
+        enum {
+            value_mask = 7, // the kind of value starting with the code unit, one of:
+            value_none = 0,
+            value_string = 1,
+            value_array = 2,
+            value_object = 3,
+            value_word = 4, // null, true or false
+            value_number = 5,
+            space = 8,
+            new_line = 16,
+            alpha = 32,
+            digit = 64,
+        };
 
         private:
-        json_value_kind kind_;
-        StringT_ data_; // data of json value. 
-        JUJSON_DEFAULT_CONTAINER<json_value> childs_;
+        struct table_type {
+            unsigned char classes[256];
+
+            table_type() {
+                for (unsigned i = 0; i < 256; ++i)
+                    classes[i] = classify(static_cast<char_type>(i));
+            }
+        };
 
         public:
-        ///@brief Constructs a default json_value object with invalid kind.
-        json_value() : kind_(JUSJON_JSON_VALUE_INVALID), data_(), childs_() {
-            
+        /// @brief Checks if a code unit is ASCII and JUJSON_IS_SPACE. @param c the code unit. @return True for a space, false otherwise.
+        [[nodiscard]] static bool is_space(char_type c) {
+            const unsigned_type u = static_cast<unsigned_type>(c);
+            return (u < 128) && JUJSON_IS_SPACE(static_cast<int>(u));
         }
-        /// @brief Constructs a json_value object with the specified kind. @param kind the kind of the json_value.
-        json_value(json_value_kind kind) : kind_(kind), data_(), childs_() {
+        /// @brief Checks if a code unit is ASCII and JUJSON_IS_ALPHA. @param c the code unit. @return True for a letter, false otherwise.
+        [[nodiscard]] static bool is_alpha(char_type c) {
+            const unsigned_type u = static_cast<unsigned_type>(c);
+            return (u < 128) && JUJSON_IS_ALPHA(static_cast<int>(u));
+        }
+        /// @brief Checks if a code unit is ASCII and JUJSON_IS_DIGIT. @param c the code unit. @return True for a digit, false otherwise.
+        [[nodiscard]] static bool is_digit(char_type c) {
+            const unsigned_type u = static_cast<unsigned_type>(c);
+            return (u < 128) && JUJSON_IS_DIGIT(static_cast<int>(u));
+        }
+        /// @brief Classifies a code unit with the predicates, in the order the parsers test them. @param c the code unit. @return Its classes.
+        [[nodiscard]] static unsigned char classify(char_type c) {
+            unsigned char result = value_none;
+            if (is_alpha(c))
+                result = value_word;
+            else if (JSONTraitsT_::is_string_litteral_begin(c))
+                result = value_string;
+            else if (JSONTraitsT_::is_array_begin(c))
+                result = value_array;
+            else if (JSONTraitsT_::is_object_begin(c))
+                result = value_object;
+            else if (is_digit(c) || JSONTraitsT_::is_minus(c))
+                result = value_number;
+            result |= is_space(c) ? space : 0;
+            result |= JSONTraitsT_::is_new_line(c) ? new_line : 0;
+            result |= is_alpha(c) ? alpha : 0;
+            result |= is_digit(c) ? digit : 0;
+            return static_cast<unsigned char>(result);
+        }
+        /// @brief Gets the table of the first 256 code units, built on the first call. @return The table, to pass to get().
+        [[nodiscard]] static const unsigned char* table() {
+            static const table_type result;
+            return result.classes;
+        }
+        /// @brief Gets the classes of a code unit. @param classes the result of table(). @param c the code unit. @return Its classes.
+        [[nodiscard]] static unsigned char get(const unsigned char* classes, char_type c) {
+            const unsigned_type u = static_cast<unsigned_type>(c);
+            return (u < 256) ? classes[u] : classify(c);
+        }
+    };
+    /**
+     * @brief Describes how json_parser and json_value create strings of type StringT_.
+     *        Owning strings are copied out of the input; specialize it for string types that can not be built from an iterator range.
+     * @tparam StringT_ the type of the string to use.
+     */
+    template<class StringT_>
+    struct string_traits {
+        public:
+        typedef StringT_ string_type;
+        typedef StringT_ owning_string_type; // type returned by to_string() and decoded_data().
 
+        private:
+        template<class IteratorT_, class AllocatorT_>
+        static string_type make(IteratorT_ b, IteratorT_ e, const AllocatorT_& alloc, ::std::true_type) {
+            return string_type(b, e, alloc);
+        }
+        template<class IteratorT_, class AllocatorT_>
+        static string_type make(IteratorT_ b, IteratorT_ e, const AllocatorT_&, ::std::false_type) {
+            return string_type(b, e);
+        }
+        template<class AllocatorT_>
+        static string_type copy(const string_type& str, const AllocatorT_& alloc, ::std::true_type) {
+            return string_type(str, alloc);
+        }
+        template<class AllocatorT_>
+        static string_type copy(const string_type& str, const AllocatorT_&, ::std::false_type) {
+            return string_type(str);
+        }
+        template<class AllocatorT_>
+        static string_type move(string_type&& str, const AllocatorT_& alloc, ::std::true_type) {
+            return string_type(JUJSON_MOVE(str), alloc);
+        }
+        template<class AllocatorT_>
+        static string_type move(string_type&& str, const AllocatorT_&, ::std::false_type) {
+            return string_type(JUJSON_MOVE(str));
         }
-        /**
-         * @brief Constructs a json_value object with the specified data and kind.
-         * @param data the data of the json_value.
-         * @param kind the kind of the json_value.
-         */
-        json_value(const StringT_& data, json_value_kind kind) : kind_(kind), data_(data), childs_() {
 
+        public:
+        /// @brief Creates a string from the range [b, e). @param b the beginning iterator. @param e the ending iterator.
+        template<class IteratorT_>
+        [[nodiscard]] static string_type make(IteratorT_ b, IteratorT_ e) {
+            return string_type(b, e);
         }
-        /** 
-         * @brief Constructs a json_value object with the specified data and kind, moving the data.
-         * @param data the data of the json_value.
-         * @param kind the kind of the json_value.
+        /**
+         * @brief Creates a string from the range [b, e), allocated with alloc if string_type is allocator-aware.
+         * @param b the beginning iterator. @param e the ending iterator. @param alloc the allocator to use.
          */
-        json_value(StringT_&& data, json_value_kind kind) : kind_(kind), data_(JUJSON_MOVE(data)), childs_() {
-
+        template<class IteratorT_, class AllocatorT_>
+        [[nodiscard]] static string_type make(IteratorT_ b, IteratorT_ e, const AllocatorT_& alloc) {
+            return make(b, e, alloc, ::std::integral_constant<bool, ::std::uses_allocator<string_type, AllocatorT_>::value>());
+        }
+        /// @brief Copies the string, allocated with alloc if string_type is allocator-aware. @param str the string to copy. @param alloc the allocator to use.
+        template<class AllocatorT_>
+        [[nodiscard]] static string_type copy(const string_type& str, const AllocatorT_& alloc) {
+            return copy(str, alloc, ::std::integral_constant<bool, ::std::uses_allocator<string_type, AllocatorT_>::value>());
         }
+        /// @brief Moves the string, copies it if string_type is allocator-aware and allocators differ. @param str the string to move. @param alloc the allocator to use.
+        template<class AllocatorT_>
+        [[nodiscard]] static string_type move(string_type&& str, const AllocatorT_& alloc) {
+            return move(JUJSON_MOVE(str), alloc, ::std::integral_constant<bool, ::std::uses_allocator<string_type, AllocatorT_>::value>());
+        }
+    };
+#if (JUJSON_HAS_STRING_VIEW)
+    /**
+     * @brief Zero-copy strings: values refer to the caller's buffer, which must outlive them.
+     *        Iterators of the range must point to contiguous memory.
+     */
+    template<class CharT_, class CharTraitsT_>
+    struct string_traits<::std::basic_string_view<CharT_, CharTraitsT_>> {
+        public:
+        typedef ::std::basic_string_view<CharT_, CharTraitsT_> string_type;
+        typedef ::std::basic_string<CharT_, CharTraitsT_> owning_string_type;
 
         public:
-        /// @brief Gets the child elements of the json_value. @return A reference to the container of child elements.
-        [[nodiscard]] JUJSON_DEFAULT_CONTAINER<json_value>& get_childs() {
-            return childs_;
+        /// @brief Creates a view of the range [b, e). @param b the beginning iterator. @param e the ending iterator.
+        template<class IteratorT_>
+        [[nodiscard]] static string_type make(IteratorT_ b, IteratorT_ e) {
+            if (b == e)
+                return string_type();
+            return string_type(&*b, static_cast<typename string_type::size_type>(e - b));
         }
-        /// @brief Gets the child elements of the json_value. @return A reference to the container of child elements.
-        [[nodiscard]] const JUJSON_DEFAULT_CONTAINER<json_value>& get_childs() const noexcept {
-            return childs_;
-        }
-        /// @brief Gets the kind of the json_value. @return The kind of the json_value.
-        [[nodiscard]] json_value_kind kind() const noexcept {
-            return kind_;
+        /// @brief Creates a view of the range [b, e), views never allocate. @param b the beginning iterator. @param e the ending iterator.
+        template<class IteratorT_, class AllocatorT_>
+        [[nodiscard]] static string_type make(IteratorT_ b, IteratorT_ e, const AllocatorT_&) {
+            return make(b, e);
         }
-        /// @brief Checks if the json_value is valid. @return True if the json_value is valid, false otherwise.
-        [[nodiscard]] bool is_valid() const noexcept {
-            return kind_ != JUSJON_JSON_VALUE_INVALID;
+        /// @brief Copies the view, views never allocate. @param str the view to copy.
+        template<class AllocatorT_>
+        [[nodiscard]] static string_type copy(const string_type& str, const AllocatorT_&) {
+            return str;
         }
-        /// @brief Gets the data of the json_value. @return A const reference to the data of the json_value.
-        [[nodiscard]] const StringT_& data() const {
-            return data_;
-        }     
-        /// @brief Gets the first child element if kind is equal to JUSJON_JSON_VALUE_KEY. @return A const reference to the child element.
-        [[nodiscard]] const json_value& value() const {
-            if (kind_ != JUSJON_JSON_VALUE_KEY)
-                JUJSON_ASSERT(false);
-            return childs_[0];
-        }     
-        /// @brief Adds a child element to the json_value. @param obj the child element to add.
-        void add_child(const json_value& obj) {
-            return childs_.push_back(obj);
-        }   
-        /// @brief Adds a child element to the json_value, moving the element. @param obj the child element to add.
-        void add_child(json_value&& obj) {
-            return childs_.push_back(JUJSON_MOVE(obj));
+        /// @brief Moves the view, views never allocate. @param str the view to move.
+        template<class AllocatorT_>
+        [[nodiscard]] static string_type move(string_type&& str, const AllocatorT_&) {
+            return str;
         }
-        /**
-         * @brief Finds a child element with the specified key.
-         * @param toFind the key to find.
-         * @return An iterator to the found element, or end() if not found. RETURNS KV(KEY/VALUE) NOT A VALUE ITSELF.
-         */
-        [[nodiscard]] typename JUJSON_DEFAULT_CONTAINER<json_value>::iterator find(const StringT_& toFind) noexcept {
-            if (kind_ != JUSJON_JSON_VALUE_OBJECT)
-                return childs_.end();
-            for (auto i = childs_.begin(); i != childs_.end(); ++i) {
-                if (i->data_ == toFind)
-                    return i;
+    };
+#endif
+    /**
+     * @brief Appends the code point to the string, encoded as UTF-8, UTF-16 or UTF-32 depending on the size of the character type.
+     * @param result the string to append to.
+     * @param cp the code point to append.
+     */
+    template<class OutStringT_>
+    void append_code_point(OutStringT_& result, char32_t cp) {
+        typedef typename OutStringT_::value_type char_type;
+        if (sizeof(char_type) >= 4) {
+            result += static_cast<char_type>(cp);
+        } else if (sizeof(char_type) == 2) {
+            if (cp >= 0x10000) {
+                cp -= 0x10000;
+                result += static_cast<char_type>(0xD800 + (cp >> 10));
+                result += static_cast<char_type>(0xDC00 + (cp & 0x3FF));
+            } else {
+                result += static_cast<char_type>(cp);
             }
-            return childs_.end();
+        } else if (cp < 0x80) {
+            result += static_cast<char_type>(cp);
+        } else if (cp < 0x800) {
+            result += static_cast<char_type>(0xC0 | (cp >> 6));
+            result += static_cast<char_type>(0x80 | (cp & 0x3F));
+        } else if (cp < 0x10000) {
+            result += static_cast<char_type>(0xE0 | (cp >> 12));
+            result += static_cast<char_type>(0x80 | ((cp >> 6) & 0x3F));
+            result += static_cast<char_type>(0x80 | (cp & 0x3F));
+        } else {
+            result += static_cast<char_type>(0xF0 | (cp >> 18));
+            result += static_cast<char_type>(0x80 | ((cp >> 12) & 0x3F));
+            result += static_cast<char_type>(0x80 | ((cp >> 6) & 0x3F));
+            result += static_cast<char_type>(0x80 | (cp & 0x3F));
+        }
+    }
+    /**
+     * @brief Reads 4 hex digits of \\uXXXX escape. @param b the beginning iterator, moved past the digits on success.
+     * @param e the ending iterator. @param cp the read value. @return True if 4 hex digits were read, false otherwise.
+     */
+    template<class IteratorT_>
+    bool read_hex4(IteratorT_& b, IteratorT_ e, char32_t& cp) {
+        char32_t result = 0;
+        IteratorT_ i = b;
+        for (int n = 0; n < 4; ++n, ++i) {
+            if (i == e)
+                return false;
+            const char32_t c = static_cast<char32_t>(*i);
+            if ((c >= '0') && (c <= '9'))       result = (result << 4) | (c - '0');
+            else if ((c >= 'a') && (c <= 'f'))  result = (result << 4) | (c - 'a' + 10);
+            else if ((c >= 'A') && (c <= 'F'))  result = (result << 4) | (c - 'A' + 10);
+            else                                return false;
         }
+        b = i;
+        cp = result;
+        return true;
+    }
+    /// @brief Checks of UTF-8, UTF-16 and UTF-32 code unit sequences.
+    namespace encoding {
         /**
-         * @brief Finds a child element with the specified key.
-         * @param toFind the key to find.
-         * @return An iterator to the found element, or end() if not found.
+         * @brief Gets the length of the UTF-8 sequence at b: no overlong forms, no surrogates, nothing above U+10FFFF.
+         * @param b the beginning iterator, not e. @param e the ending iterator.
+         * @return The number of code units of the sequence, 0 if it is invalid or truncated.
          */
-        [[nodiscard]] typename JUJSON_DEFAULT_CONTAINER<json_value>::const_iterator find(const StringT_& toFind) const noexcept {
-            if (kind_ != JUSJON_JSON_VALUE_OBJECT)
-                return childs_.end();
-            for (auto i = childs_.begin(); i != childs_.end(); ++i) {
-                if (i->data_ == toFind)
-                    return i;
+        template<class IteratorT_>
+        unsigned utf8_length(IteratorT_ b, IteratorT_ e) {
+            const unsigned char lead = static_cast<unsigned char>(*b);
+            if (lead < 0x80)
+                return 1;
+            unsigned length = 2;
+            unsigned char low = 0x80; // range of the second code unit
+            unsigned char high = 0xBF;
+            if ((lead < 0xC2) || (lead > 0xF4)) {
+                return 0;
+            } else if (lead >= 0xF0) {
+                length = 4;
+                low = (lead == 0xF0) ? 0x90 : 0x80;
+                high = (lead == 0xF4) ? 0x8F : 0xBF;
+            } else if (lead >= 0xE0) {
+                length = 3;
+                low = (lead == 0xE0) ? 0xA0 : 0x80;
+                high = (lead == 0xED) ? 0x9F : 0xBF;
             }
-            return childs_.end();
+            IteratorT_ i = b;
+            for (unsigned n = 1; n < length; ++n) {
+                if (++i == e)
+                    return 0;
+                const unsigned char c = static_cast<unsigned char>(*i);
+                if ((n == 1) ? ((c < low) || (c > high)) : ((c & 0xC0) != 0x80))
+                    return 0;
+            }
+            return length;
         }
-        /**
-         * @brief Converts the json_value to a string.
-         * @tparam ToStringT_ the type of the string to use.
-         * @tparam ToJSONTraitsT_ the traits class used to define JSON-specific characteristics.
-         * @return the string representation of the json_value.
-         */
-        template<class ToStringT_ = StringT_, class ToJSONTraitsT_ = default_json_traits<typename ToStringT_::value_type>>
-        [[nodiscard]] ToStringT_ to_string() const {
-            using c_json_traits = ToJSONTraitsT_;
-            switch (kind_) {
-            case JUSJON_JSON_VALUE_ARRAY: {
-                ToStringT_ result;
-                result += c_json_traits::get_array_begin();
-                auto i = childs_.begin();
-                for (; i != childs_.end() - 1; ++i) {
-                    result += i->to_string() + c_json_traits::get_comma();
-                }
-                result += i->to_string() + c_json_traits::get_array_end();
-                return result;
+        /// @brief Finds the first code unit that does not begin a valid UTF-8 sequence. @param b the beginning iterator. @param e the ending iterator. @return The found code unit, or e.
+        template<class IteratorT_>
+        IteratorT_ find_invalid_utf8(IteratorT_ b, IteratorT_ e) {
+            while (b != e) {
+                const unsigned length = utf8_length(b, e);
+                if (length == 0)
+                    return b;
+                ::std::advance(b, length);
             }
-            case JUSJON_JSON_VALUE_OBJECT: {
-                ToStringT_ result;
-                result += c_json_traits::get_object_begin();
-                auto i = childs_.begin();
-                for (; i != childs_.end() - 1; ++i) {
-                    result += i->to_string() + c_json_traits::get_comma();
-                }
-                result += i->to_string() + c_json_traits::get_object_end();
-                return result;
+            return e;
+        }
+        /// @brief Finds the first code unit that is a lone surrogate. @param b the beginning iterator. @param e the ending iterator. @return The found code unit, or e.
+        template<class IteratorT_>
+        IteratorT_ find_invalid_utf16(IteratorT_ b, IteratorT_ e) {
+            for (; b != e; ++b) {
+                const ::std::uint32_t c = static_cast<::std::uint16_t>(*b);
+                if ((c < 0xD800) || (c >= 0xE000))
+                    continue;
+                IteratorT_ low = b;
+                if ((c >= 0xDC00) || (++low == e) || (static_cast<::std::uint16_t>(*low) < 0xDC00) || (static_cast<::std::uint16_t>(*low) >= 0xE000))
+                    return b;
+                b = low;
             }
-            case JUSJON_JSON_VALUE_KEY:
-                return ToStringT_(c_json_traits::get_string_litteral_begin() + data_ + c_json_traits::get_string_litteral_end() + c_json_traits::get_colon() + childs_[0].to_string());
-            case JUSJON_JSON_VALUE_STRING:
-                return ToStringT_(c_json_traits::get_string_litteral_begin() + data_ + c_json_traits::get_string_litteral_end());
-            case JUSJON_JSON_VALUE_NULL:
-            case JUSJON_JSON_VALUE_TRUE:
-            case JUSJON_JSON_VALUE_FALSE:
-            case JUSJON_JSON_VALUE_NUMBER:
-                return ToStringT_(data_);
-            default:
-                return ToStringT_();
+            return e;
+        }
+        /// @brief Finds the first code unit that is a surrogate or above U+10FFFF. @param b the beginning iterator. @param e the ending iterator. @return The found code unit, or e.
+        template<class IteratorT_>
+        IteratorT_ find_invalid_utf32(IteratorT_ b, IteratorT_ e) {
+            for (; b != e; ++b) {
+                const ::std::uint32_t c = static_cast<::std::uint32_t>(*b);
+                if (((c >= 0xD800) && (c < 0xE000)) || (c > 0x10FFFF))
+                    return b;
             }
-            return ToStringT_();
+            return e;
         }
-        
+    }
+    enum json_number_kind {
+        JUJSON_NUMBER_KIND_INVALID, // not a number
+        JUJSON_NUMBER_KIND_INT64,
+        JUJSON_NUMBER_KIND_UINT64,  // integers above the int64 range only
+        JUJSON_NUMBER_KIND_DOUBLE,
     };
-    /**
-     * @brief A robust JSON parser designed to convert JSON-formatted strings into structured json_value objects.
-     *        This class handles various JSON data types, including null, boolean(true, false), string, number, array, and object.
-     *        It provides methods to parse JSON strings, manage parsing errors, and track the current position in the input string.
-     * @tparam StringT_ the type of the string used to use.
-     * @tparam JSONTraitsT_ the traits class used to define JSON-specific characteristics.
-     */
-    template<class StringT_, class JSONTraitsT_ = default_json_traits<typename StringT_::value_type>>
-    struct json_parser final {
-        private:
-        typedef JSONTraitsT_ json_traits;
-        typedef json_value<StringT_, json_traits> json_value_type;
-
-        public:
-        typedef typename StringT_::const_iterator const_iterator;
-
-        private:
-        JUJSON_SIZE_TYPE line_;
-        JUJSON_SIZE_TYPE column_;
-        const_iterator current_;
-        const_iterator end_;
-        error_code lastError_;
+    /// @brief A decoded JSON number.
+    struct json_number {
+        json_number_kind kind;
+        union {
+            ::std::int64_t i;
+            ::std::uint64_t u;
+            double d;
+        };
 
-        public:
-        /// @brief Constructs a json_parser object with the specified string. @param str the string to parse.
-        json_parser(const StringT_& str) : line_(0), column_(0), current_(str.begin()), end_(str.end()), lastError_(JUJSON_ERROR_CODE_SUCCESS) {
+        json_number() : kind(JUJSON_NUMBER_KIND_INVALID), u(0) {
 
         }
-        /// @brief Constructs a json_parser object with the specified iterators. @param b the beginning iterator. @param e the ending iterator.
-        json_parser(const_iterator b, const_iterator e) : line_(0), column_(0), current_(b), end_(e), lastError_(JUJSON_ERROR_CODE_SUCCESS) {
-
+        /// @brief Checks if the number is an integer. @return True for JUJSON_NUMBER_KIND_INT64 and JUJSON_NUMBER_KIND_UINT64.
+        [[nodiscard]] bool is_integer() const noexcept {
+            return (kind == JUJSON_NUMBER_KIND_INT64) || (kind == JUJSON_NUMBER_KIND_UINT64);
         }
-
-        private:
-        bool skip_spaces() {
-            for (auto val = *current_;current_ != end_; ++current_, val = *current_) { // skip spaces
-                if (!JUJSON_IS_SPACE(val)) {
-                    return true;
-                }
-
-                if (json_traits::is_new_line(val)) {
-                    column_ = 0;
-                    ++line_;
-                } else {
-                    ++column_;
-                }
+        /// @brief Gets the number as int64, doubles are truncated and saturated. @return The number, 0 if invalid.
+        [[nodiscard]] ::std::int64_t as_int64() const noexcept {
+            switch (kind) {
+            case JUJSON_NUMBER_KIND_INT64:  return i;
+            case JUJSON_NUMBER_KIND_UINT64: return INT64_MAX;
+            case JUJSON_NUMBER_KIND_DOUBLE:
+                if (!(d > -9223372036854775808.0)) // NaN included
+                    return (d != d) ? 0 : INT64_MIN;
+                return (d >= 9223372036854775808.0) ? INT64_MAX : static_cast<::std::int64_t>(d);
+            default:                        return 0;
             }
-            return false;
         }
-        StringT_ parse_word() {
-            auto b = current_;
-            for (auto val = *current_ ;(current_ != end_) && (JUJSON_IS_ALPHA(val)); ++current_, val = *current_) { // pass non spaces
-                ++column_;
+        /// @brief Gets the number as uint64, negative numbers give 0, doubles are truncated and saturated. @return The number, 0 if invalid.
+        [[nodiscard]] ::std::uint64_t as_uint64() const noexcept {
+            switch (kind) {
+            case JUJSON_NUMBER_KIND_INT64:  return (i < 0) ? 0 : static_cast<::std::uint64_t>(i);
+            case JUJSON_NUMBER_KIND_UINT64: return u;
+            case JUJSON_NUMBER_KIND_DOUBLE:
+                if (!(d > 0.0))
+                    return 0;
+                return (d >= 18446744073709551616.0) ? UINT64_MAX : static_cast<::std::uint64_t>(d);
+            default:                        return 0;
             }
-            return StringT_(b, current_);
         }
-        StringT_ parse_number() {
-            const auto skipInteger = [](const_iterator& current, const_iterator end, JUJSON_SIZE_TYPE& column) {
-                for (auto val = *current;current != end; ++current, val = *current) { // skip spaces
-                    if (!JUJSON_IS_DIGIT(val)) {
-                        return true;
-                    }
-                    ++column;
-                }
-                return false;
-            };
-            auto b = current_;
-            if (json_traits::is_minus(*current_)) {
-                ++current_;
-                ++column_;
-            }
-            skipInteger(current_, end_, column_);
-            if (json_traits::is_dec_separator_symbol(*current_)) {
-                ++current_;
-                ++column_;
-                if (!skipInteger(current_, end_, column_))
-                    return StringT_(b, current_);
+        /// @brief Gets the number as double. @return The number, 0 if invalid.
+        [[nodiscard]] double as_double() const noexcept {
+            switch (kind) {
+            case JUJSON_NUMBER_KIND_INT64:  return static_cast<double>(i);
+            case JUJSON_NUMBER_KIND_UINT64: return static_cast<double>(u);
+            case JUJSON_NUMBER_KIND_DOUBLE: return d;
+            default:                        return 0.0;
             }
-            if (json_traits::is_exp_symbol(*current_)) {
-                ++current_;
-                ++column_;
-                if (!skipInteger(current_, end_, column_))
-                    return StringT_(b, current_);
+        }
+    };
+    namespace simd {
+        template<class IteratorT_> struct is_contiguous_char_iterator;
+    }
+    /// @brief Converts number text to double, mapping the characters of the traits to narrow ones on the stack. @param b the beginning iterator. @param e the ending iterator. @return The converted number.
+    template<class JSONTraitsT_, class IteratorT_>
+    [[nodiscard]] double json_number_to_double(IteratorT_ b, IteratorT_ e, ::std::false_type) {
+        const ::std::size_t size = static_cast<::std::size_t>(::std::distance(b, e));
+        char buffer[64];
+        ::std::string longText; // only for lexemes with more digits than a double can use
+        char* text = buffer;
+        if (size >= sizeof(buffer)) {
+            longText.resize(size + 1);
+            text = &longText[0];
+        }
+        for (char* p = text; b != e; ++b, ++p) {
+            const auto val = *b;
+            if (JSONTraitsT_::is_dec_separator_symbol(val))     *p = '.';
+            else if (JSONTraitsT_::is_exp_symbol(val))          *p = 'e';
+            else if (JSONTraitsT_::is_minus(val))               *p = '-';
+            else                                                *p = static_cast<char>(val);
+        }
+        text[size] = 0;
+#if (JUJSON_HAS_FROM_CHARS)
+        double result = 0.0;
+        if (::std::from_chars(text, text + size, result).ec != ::std::errc::result_out_of_range)
+            return result;
+#endif
+        const char point = *::std::localeconv()->decimal_point; // strtod uses the separator of the C locale
+        if (point != '.')
+            ::std::replace(text, text + size, '.', point);
+        return ::std::strtod(text, nullptr); // infinity or zero out of range
+    }
+    /// @brief Converts contiguous char text with default traits to double, with from_chars on the input itself if available. @param b the beginning iterator. @param e the ending iterator. @return The converted number.
+    template<class JSONTraitsT_, class IteratorT_>
+    [[nodiscard]] double json_number_to_double(IteratorT_ b, IteratorT_ e, ::std::true_type) {
+#if (JUJSON_HAS_FROM_CHARS)
+        if (b != e) {
+            const char* const text = &*b;
+            double result = 0.0;
+            if (::std::from_chars(text, text + (e - b), result).ec != ::std::errc::result_out_of_range)
+                return result;
+        }
+#endif
+        return json_number_to_double<JSONTraitsT_>(b, e, ::std::false_type()); // strtod needs a terminated copy
+    }
+    /**
+     * @brief Converts number text to double when the fast path can't, with from_chars if available, strtod otherwise and out of range.
+     *        Nothing is allocated unless the text is longer than 63 characters.
+     * @param b the beginning iterator. @param e the ending iterator. @return The converted number.
+     */
+    template<class JSONTraitsT_, class IteratorT_>
+    [[nodiscard]] double json_number_to_double(IteratorT_ b, IteratorT_ e) {
+        return json_number_to_double<JSONTraitsT_>(b, e, ::std::integral_constant<bool, ::std::is_same<JSONTraitsT_, default_json_traits<char>>::value &&
+            simd::is_contiguous_char_iterator<IteratorT_>::value>());
+    }
+    /**
+     * @brief Decodes the text of a JSON number. Integers become int64, or uint64 above the int64 range, others double.
+     *        Doubles with up to 2^53 in the digits and powers of ten up to 22 are computed exactly from integers (Clinger's fast path),
+     *        others are converted by json_number_to_double.
+     * @tparam JSONTraitsT_ the traits class used to define JSON-specific characteristics.
+     * @param b the beginning iterator. @param e the ending iterator.
+     * @return The decoded number, JUJSON_NUMBER_KIND_INVALID if the text is not a number.
+     */
+    template<class JSONTraitsT_, class IteratorT_>
+    [[nodiscard]] json_number decode_json_number(IteratorT_ b, IteratorT_ e) {
+        static const double powers[] = {1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11, 1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22};
+        json_number result;
+        IteratorT_ p = b;
+        const bool negative = (p != e) && JSONTraitsT_::is_minus(*p);
+        if (negative)
+            ++p;
+        ::std::uint64_t mantissa = 0;
+        bool truncated = false; // digits not in mantissa
+        bool anyDigit = false;
+        bool integer = true;
+        long exponent = 0;
+        for (; (p != e) && json_char_classes<JSONTraitsT_>::is_digit(*p); ++p) {
+            const unsigned digit = static_cast<unsigned>(*p - '0');
+            anyDigit = true;
+            if (!truncated && (mantissa <= (UINT64_MAX - digit) / 10)) {
+                mantissa = mantissa * 10 + digit;
+            } else {
+                truncated = true;
+                ++exponent;
             }
-            return StringT_(b, current_);
         }
-        StringT_ parse_string_litteral() {
-            auto b = current_;
-            bool slash = false;
-            JUJSON_SIZE_TYPE beginsCount = 1;
-            for (auto val = *current_; current_ != end_; ++current_, val = *current_) { // pass to string itteral end
-                slash = false;
-                if (json_traits::is_escape_spec(val)) {
-                    slash = true;
-                    ++current_;
-                    ++column_;
-                    continue;
-                }
-                if ((!slash) && json_traits::is_string_litteral_end(val)) {
-                    --beginsCount;
-                    ++column_;
-                } else if ((!slash) && json_traits::is_string_litteral_begin(val))  {
-                    ++beginsCount;
-                    ++column_;
-                } else if (json_traits::is_new_line(val)) {
-                    column_ = 0;
-                    ++line_;
+        if ((p != e) && JSONTraitsT_::is_dec_separator_symbol(*p)) {
+            integer = false;
+            for (++p; (p != e) && json_char_classes<JSONTraitsT_>::is_digit(*p); ++p) {
+                const unsigned digit = static_cast<unsigned>(*p - '0');
+                anyDigit = true;
+                if (!truncated && (mantissa <= (UINT64_MAX - digit) / 10)) {
+                    mantissa = mantissa * 10 + digit;
+                    --exponent;
                 } else {
-                    ++column_;
-                }
-                if (beginsCount == 0) {
-                    ++current_;
-                    return StringT_(b, current_ - 1);
+                    truncated = true;
                 }
             }
-            lastError_ = JUJSON_ERROR_CODE_EOF;
-            return StringT_();
         }
-        StringT_ parse_string_litteral_expected() {
-            if (!skip_spaces()) {
-                lastError_ = JUJSON_ERROR_CODE_EOF;
-                return StringT_();
+        if ((p != e) && JSONTraitsT_::is_exp_symbol(*p)) {
+            integer = false;
+            bool negativeExponent = false;
+            if ((++p != e) && (JSONTraitsT_::is_minus(*p) || (*p == '+'))) {
+                negativeExponent = JSONTraitsT_::is_minus(*p);
+                ++p;
             }
-            if (!json_traits::is_string_litteral_begin(*current_)) {
-                lastError_ = JUJSON_ERROR_CODE_UNEXPECTED;
-                return StringT_();
+            long value = 0;
+            bool exponentDigit = false;
+            for (; (p != e) && json_char_classes<JSONTraitsT_>::is_digit(*p); ++p) {
+                exponentDigit = true;
+                if (value < 100000)
+                    value = value * 10 + static_cast<long>(*p - '0');
             }
-            ++current_;
-            ++column_;
-            return parse_string_litteral();
+            if (!exponentDigit)
+                return result;
+            exponent += negativeExponent ? -value : value;
         }
-        json_value_type parse_word_json() {
-            StringT_ str = parse_word();
-            const json_value_kind kind = json_traits::value_kind_from_string(str);
-            if (kind == JUSJON_JSON_VALUE_INVALID) {
-                lastError_ = JUJSON_ERROR_CODE_UNEXPECTED;
-                return json_value_type(); 
+        if ((p != e) || !anyDigit)
+            return result;
+        if (integer && !truncated) {
+            if (mantissa <= static_cast<::std::uint64_t>(INT64_MAX)) {
+                result.kind = JUJSON_NUMBER_KIND_INT64;
+                result.i = negative ? -static_cast<::std::int64_t>(mantissa) : static_cast<::std::int64_t>(mantissa);
+                return result;
             }
-            return json_value_type(JUJSON_MOVE(str), kind);
-        }
-        json_value_type parse_number_json() {
-            const StringT_ str = parse_number();
-            if (str.empty()) {
-                lastError_ = JUJSON_ERROR_CODE_EOF;
-                return json_value_type();
+            if (!negative) {
+                result.kind = JUJSON_NUMBER_KIND_UINT64;
+                result.u = mantissa;
+                return result;
             }
-            return json_value_type(str, JUSJON_JSON_VALUE_NUMBER); 
-        }
-        json_value_type parse_json_array() {
-            json_value_type arrayResult(JUSJON_JSON_VALUE_ARRAY);
-            bool commaExpected = false;
-            for (;;) {
-                if (!skip_spaces())
-                    break;
-                auto val = *current_;
-
-                if (json_traits::is_array_end(val)) {
-                    ++column_;
-                    ++current_;
-                    return arrayResult;
-                } else if (commaExpected) { 
-                    if (!json_traits::is_comma(val)) {
-                        lastError_ = JUJSON_ERROR_CODE_UNEXPECTED;
-                        return json_value_type();
-                    }
-                    commaExpected = false;
-                    ++column_;
-                    ++current_;
-                    continue;
-                }
-                json_value_type newChild = parse_any_value();
-                if (!newChild.is_valid())
-                    return json_value_type();
-                arrayResult.add_child(JUJSON_MOVE(newChild));
-                commaExpected = true;
+            if (mantissa == static_cast<::std::uint64_t>(INT64_MAX) + 1) {
+                result.kind = JUJSON_NUMBER_KIND_INT64;
+                result.i = INT64_MIN;
+                return result;
             }
-            lastError_ = JUJSON_ERROR_CODE_EOF;
-            return json_value_type();
         }
-        
-        json_value_type parse_json_array_expected() {
-            for (auto val = *current_; current_ != end_; ++current_, val = *current_) { // skip spaces
-                if (json_traits::is_array_begin(val)) {
-                    ++current_;
-                    return parse_json_array();
-                }
+        result.kind = JUJSON_NUMBER_KIND_DOUBLE;
+        if (!truncated && (mantissa <= (static_cast<::std::uint64_t>(1) << 53)) && (exponent >= -22) && (exponent <= 22)) {
+            result.d = static_cast<double>(mantissa);
+            result.d = (exponent < 0) ? result.d / powers[-exponent] : result.d * powers[exponent];
+            if (negative)
+                result.d = -result.d;
+            return result;
+        }
+        if (mantissa == 0 && !truncated) {
+            result.d = negative ? -0.0 : 0.0;
+            return result;
+        }
+        result.d = json_number_to_double<JSONTraitsT_>(b, e);
+        return result;
+    }
+    /**
+     * @brief Formats the shortest text that converts back to the number: 1e999 for infinity, which overflows back to it, null for NaN.
+     * @param number the number. @param buffer the buffer for the text, at least 32 characters.
+     * @return The end of the text, buffer for invalid numbers.
+     */
+    inline char* format_json_number(const json_number& number, char* buffer) {
+        switch (number.kind) {
+        case JUJSON_NUMBER_KIND_INT64:
+        case JUJSON_NUMBER_KIND_UINT64: {
+            char digits[24];
+            char* p = digits + sizeof(digits);
+            const bool negative = (number.kind == JUJSON_NUMBER_KIND_INT64) && (number.i < 0);
+            ::std::uint64_t value = (number.kind == JUJSON_NUMBER_KIND_UINT64) ? number.u : static_cast<::std::uint64_t>(number.i);
+            if (negative)
+                value = 0 - value;
+            do {
+                *--p = static_cast<char>('0' + value % 10);
+                value /= 10;
+            } while (value != 0);
+            if (negative)
+                *--p = '-';
+            const ::std::size_t size = static_cast<::std::size_t>(digits + sizeof(digits) - p);
+            ::std::memcpy(buffer, p, size);
+            return buffer + size;
+        }
+        case JUJSON_NUMBER_KIND_DOUBLE: {
+            if (number.d != number.d) { // not representable in JSON
+                ::std::memcpy(buffer, "null", 4);
+                return buffer + 4;
+            }
+            if (number.d - number.d != 0.0) { // infinity, from a number too large for a double
+                char* p = buffer;
+                if (number.d < 0)
+                    *p++ = '-';
+                ::std::memcpy(p, "1e999", 5);
+                return p + 5;
+            }
+#if (JUJSON_HAS_FROM_CHARS)
+            return ::std::to_chars(buffer, buffer + 32, number.d).ptr;
+#else
+            char* end = buffer;
+            for (int precision = 15; precision <= 17; ++precision) { // shortest that converts back
+                end = buffer + ::std::snprintf(buffer, 32, "%.*g", precision, number.d);
+                if (::std::strtod(buffer, nullptr) == number.d)
+                    break;
+            }
+            ::std::replace(buffer, end, *::std::localeconv()->decimal_point, '.');
+            return end;
+#endif
+        }
+        default:
+            return buffer;
+        }
+    }
+    /**
+     * @brief Appends the shortest text that converts back to the number.
+     * @param str the string to append to. @param number the number.
+     */
+    template<class OutStringT_>
+    void append_json_number(OutStringT_& str, const json_number& number) {
+        typedef typename OutStringT_::value_type char_type;
+        char buffer[32];
+        const char* const end = format_json_number(number, buffer);
+        for (const char* p = buffer; p != end; ++p)
+            str += static_cast<char_type>(*p);
+    }
+    /// @brief Scanning kernels for contiguous char input, used by json_parser with default_json_traits<char>.
+    namespace simd {
+        /// @brief Gets the index of the lowest set bit. @param v the mask, must not be 0.
+        inline unsigned lowest_bit(::std::uint32_t v) noexcept {
+#if (defined _MSC_VER) && (!(defined __clang__))
+            unsigned long result;
+            _BitScanForward(&result, v);
+            return static_cast<unsigned>(result);
+#else
+            return static_cast<unsigned>(__builtin_ctz(v));
+#endif
+        }
+        /// @brief Gets the index of the highest set bit. @param v the mask, must not be 0.
+        inline unsigned highest_bit(::std::uint32_t v) noexcept {
+#if (defined _MSC_VER) && (!(defined __clang__))
+            unsigned long result;
+            _BitScanReverse(&result, v);
+            return static_cast<unsigned>(result);
+#else
+            return 31u - static_cast<unsigned>(__builtin_clz(v));
+#endif
+        }
+        /// @brief Counts set bits. @param v the mask.
+        inline unsigned bit_count(::std::uint32_t v) noexcept {
+            v = v - ((v >> 1) & 0x55555555u);
+            v = (v & 0x33333333u) + ((v >> 2) & 0x33333333u);
+            return static_cast<unsigned>((((v + (v >> 4)) & 0x0F0F0F0Fu) * 0x01010101u) >> 24);
+        }
+        /// @brief Checks for ' ', '\\t', '\\n', '\\v', '\\f' and '\\r', the "C" locale std::isspace.
+        inline bool is_space(char c) noexcept {
+            return (c == ' ') || (static_cast<unsigned char>(c - '\t') < 5);
+        }
+        /// @brief Checks for '0'-'9'.
+        inline bool is_digit(char c) noexcept {
+            return static_cast<unsigned char>(c - '0') < 10;
+        }
+        /**
+         * @brief Skips whitespaces, counting new lines. @param p the beginning. @param e the end.
+         * @param lines incremented by the number of skipped new lines. @param lastNewLine set to the last skipped new line, if any.
+         * @return The first non-whitespace character, or e.
+         */
+        inline const char* skip_spaces_scalar(const char* p, const char* e, JUJSON_SIZE_TYPE& lines, const char*& lastNewLine) noexcept {
+            for (; (p != e) && is_space(*p); ++p) {
+                if (*p == '\n') {
+                    ++lines;
+                    lastNewLine = p;
+                }
+            }
+            return p;
+        }
+        /// @brief Finds a string litteral delimiter, escape or new line. @param p the beginning. @param e the end. @return The found character, or e.
+        inline const char* find_string_special_scalar(const char* p, const char* e) noexcept {
+            for (; p != e; ++p) {
+                const char c = *p;
+                if ((c == '\"') || (c == '\\') || (c == '\n'))
+                    return p;
+            }
+            return e;
+        }
+        /// @brief Skips digits. @param p the beginning. @param e the end. @return The first non-digit character, or e.
+        inline const char* skip_digits_scalar(const char* p, const char* e) noexcept {
+            for (; (p != e) && is_digit(*p); ++p) {
+
+            }
+            return p;
+        }
+        /// @brief Finds the first code unit that does not begin a valid UTF-8 sequence, ASCII 8 bytes at a time. @param p the beginning. @param e the end. @return The found code unit, or e.
+        inline const char* find_invalid_utf8_scalar(const char* p, const char* e) noexcept {
+            while (p != e) {
+                ::std::uint64_t word = 0;
+                if ((e - p >= 8) && ((::std::memcpy(&word, p, 8), word & 0x8080808080808080ull) == 0)) {
+                    p += 8;
+                    continue;
+                }
+                const unsigned length = encoding::utf8_length(p, e);
+                if (length == 0)
+                    return p;
+                p += length;
+            }
+            return e;
+        }
+#if (JUJSON_HAS_SSE2)
+        inline const char* skip_spaces_sse2(const char* p, const char* e, JUJSON_SIZE_TYPE& lines, const char*& lastNewLine) noexcept {
+            const __m128i space = _mm_set1_epi8(' ');
+            const __m128i newLine = _mm_set1_epi8('\n');
+            const __m128i controlLow = _mm_set1_epi8('\t' - 1);
+            const __m128i controlHigh = _mm_set1_epi8('\r' + 1);
+            for (; e - p >= 16; p += 16) {
+                const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+                const __m128i control = _mm_and_si128(_mm_cmpgt_epi8(v, controlLow), _mm_cmplt_epi8(v, controlHigh));
+                const ::std::uint32_t spaces = static_cast<::std::uint32_t>(_mm_movemask_epi8(_mm_or_si128(_mm_cmpeq_epi8(v, space), control)));
+                ::std::uint32_t newLines = static_cast<::std::uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(v, newLine)));
+                if (spaces != 0xFFFFu) {
+                    const unsigned index = lowest_bit(~spaces & 0xFFFFu);
+                    newLines &= (1u << index) - 1u;
+                    if (newLines != 0) {
+                        lines += bit_count(newLines);
+                        lastNewLine = p + highest_bit(newLines);
+                    }
+                    return p + index;
+                }
+                if (newLines != 0) {
+                    lines += bit_count(newLines);
+                    lastNewLine = p + highest_bit(newLines);
+                }
+            }
+            return skip_spaces_scalar(p, e, lines, lastNewLine);
+        }
+        inline const char* find_string_special_sse2(const char* p, const char* e) noexcept {
+            const __m128i quote = _mm_set1_epi8('\"');
+            const __m128i escape = _mm_set1_epi8('\\');
+            const __m128i newLine = _mm_set1_epi8('\n');
+            for (; e - p >= 16; p += 16) {
+                const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+                const __m128i found = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(v, quote), _mm_cmpeq_epi8(v, escape)), _mm_cmpeq_epi8(v, newLine));
+                const ::std::uint32_t mask = static_cast<::std::uint32_t>(_mm_movemask_epi8(found));
+                if (mask != 0)
+                    return p + lowest_bit(mask);
+            }
+            return find_string_special_scalar(p, e);
+        }
+        inline const char* skip_digits_sse2(const char* p, const char* e) noexcept {
+            const __m128i low = _mm_set1_epi8('0' - 1);
+            const __m128i high = _mm_set1_epi8('9' + 1);
+            for (; e - p >= 16; p += 16) {
+                const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+                const ::std::uint32_t digits = static_cast<::std::uint32_t>(_mm_movemask_epi8(_mm_and_si128(_mm_cmpgt_epi8(v, low), _mm_cmplt_epi8(v, high))));
+                if (digits != 0xFFFFu)
+                    return p + lowest_bit(~digits & 0xFFFFu);
+            }
+            return skip_digits_scalar(p, e);
+        }
+        inline const char* find_invalid_utf8_sse2(const char* p, const char* e) noexcept {
+            while (e - p >= 16) {
+                const ::std::uint32_t nonAscii = static_cast<::std::uint32_t>(_mm_movemask_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(p))));
+                if (nonAscii == 0) {
+                    p += 16;
+                    continue;
+                }
+                p += lowest_bit(nonAscii); // one sequence checked, then ASCII is skipped again
+                const unsigned length = encoding::utf8_length(p, e);
+                if (length == 0)
+                    return p;
+                p += length;
+            }
+            return find_invalid_utf8_scalar(p, e);
+        }
+#endif
+#if (JUJSON_HAS_AVX2_DISPATCH)
+        __attribute__((target("avx2"))) inline const char* skip_spaces_avx2(const char* p, const char* e, JUJSON_SIZE_TYPE& lines, const char*& lastNewLine) noexcept {
+            const __m256i space = _mm256_set1_epi8(' ');
+            const __m256i newLine = _mm256_set1_epi8('\n');
+            const __m256i controlLow = _mm256_set1_epi8('\t' - 1);
+            const __m256i controlHigh = _mm256_set1_epi8('\r' + 1);
+            for (; e - p >= 32; p += 32) {
+                const __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+                const __m256i control = _mm256_and_si256(_mm256_cmpgt_epi8(v, controlLow), _mm256_cmpgt_epi8(controlHigh, v));
+                const ::std::uint32_t spaces = static_cast<::std::uint32_t>(_mm256_movemask_epi8(_mm256_or_si256(_mm256_cmpeq_epi8(v, space), control)));
+                ::std::uint32_t newLines = static_cast<::std::uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(v, newLine)));
+                if (spaces != 0xFFFFFFFFu) {
+                    const unsigned index = lowest_bit(~spaces);
+                    newLines &= (index == 0) ? 0u : (0xFFFFFFFFu >> (32u - index));
+                    if (newLines != 0) {
+                        lines += bit_count(newLines);
+                        lastNewLine = p + highest_bit(newLines);
+                    }
+                    return p + index;
+                }
+                if (newLines != 0) {
+                    lines += bit_count(newLines);
+                    lastNewLine = p + highest_bit(newLines);
+                }
+            }
+            return skip_spaces_sse2(p, e, lines, lastNewLine);
+        }
+        __attribute__((target("avx2"))) inline const char* find_string_special_avx2(const char* p, const char* e) noexcept {
+            const __m256i quote = _mm256_set1_epi8('\"');
+            const __m256i escape = _mm256_set1_epi8('\\');
+            const __m256i newLine = _mm256_set1_epi8('\n');
+            for (; e - p >= 32; p += 32) {
+                const __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+                const __m256i found = _mm256_or_si256(_mm256_or_si256(_mm256_cmpeq_epi8(v, quote), _mm256_cmpeq_epi8(v, escape)), _mm256_cmpeq_epi8(v, newLine));
+                const ::std::uint32_t mask = static_cast<::std::uint32_t>(_mm256_movemask_epi8(found));
+                if (mask != 0)
+                    return p + lowest_bit(mask);
+            }
+            return find_string_special_sse2(p, e);
+        }
+        __attribute__((target("avx2"))) inline const char* skip_digits_avx2(const char* p, const char* e) noexcept {
+            const __m256i low = _mm256_set1_epi8('0' - 1);
+            const __m256i high = _mm256_set1_epi8('9' + 1);
+            for (; e - p >= 32; p += 32) {
+                const __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+                const ::std::uint32_t digits = static_cast<::std::uint32_t>(_mm256_movemask_epi8(_mm256_and_si256(_mm256_cmpgt_epi8(v, low), _mm256_cmpgt_epi8(high, v))));
+                if (digits != 0xFFFFFFFFu)
+                    return p + lowest_bit(~digits);
+            }
+            return skip_digits_sse2(p, e);
+        }
+        /**
+         * @brief Validates UTF-8 32 bytes at a time with the lookup tables of Keiser and Lemire: every pair of adjacent bytes is classified by
+         *        the high nibble of both and the low nibble of the first, and the lengths of multibyte sequences are checked from the bytes
+         *        2 and 3 before. The first invalid code unit is then found by the SSE2 kernel, as is the tail.
+         */
+        __attribute__((target("avx2"))) inline const char* find_invalid_utf8_avx2(const char* p, const char* e) noexcept {
+            const ::std::int8_t tooShort = 1 << 0;       // 11______ 0_______ or 11______ 11______
+            const ::std::int8_t tooLong = 1 << 1;        // 0_______ 10______
+            const ::std::int8_t overlong3 = 1 << 2;      // 11100000 100_____
+            const ::std::int8_t tooLarge = 1 << 3;       // 11110100 1001____, 11110100 101_____, 11110101+ 1_______
+            const ::std::int8_t surrogate = 1 << 4;      // 11101101 101_____
+            const ::std::int8_t overlong2 = 1 << 5;      // 1100000_ 10______
+            const ::std::int8_t tooLarge1000 = 1 << 6;   // 11110101+ 1000____
+            const ::std::int8_t overlong4 = 1 << 6;      // 11110000 1000____
+            const ::std::int8_t twoConts = static_cast<::std::int8_t>(1 << 7); // 10______ 10______
+            const ::std::int8_t carry = tooShort | tooLong | twoConts;
+            const __m256i byte1High = _mm256_setr_epi8(
+                tooLong, tooLong, tooLong, tooLong, tooLong, tooLong, tooLong, tooLong, twoConts, twoConts, twoConts, twoConts,
+                tooShort | overlong2, tooShort, tooShort | overlong3 | surrogate, tooShort | tooLarge | tooLarge1000 | overlong4,
+                tooLong, tooLong, tooLong, tooLong, tooLong, tooLong, tooLong, tooLong, twoConts, twoConts, twoConts, twoConts,
+                tooShort | overlong2, tooShort, tooShort | overlong3 | surrogate, tooShort | tooLarge | tooLarge1000 | overlong4);
+            const __m256i byte1Low = _mm256_setr_epi8(
+                carry | overlong3 | overlong2 | overlong4, carry | overlong2, carry, carry, carry | tooLarge, carry | tooLarge | tooLarge1000,
+                carry | tooLarge | tooLarge1000, carry | tooLarge | tooLarge1000, carry | tooLarge | tooLarge1000, carry | tooLarge | tooLarge1000,
+                carry | tooLarge | tooLarge1000, carry | tooLarge | tooLarge1000, carry | tooLarge | tooLarge1000, carry | tooLarge | tooLarge1000 | surrogate,
+                carry | tooLarge | tooLarge1000, carry | tooLarge | tooLarge1000,
+                carry | overlong3 | overlong2 | overlong4, carry | overlong2, carry, carry, carry | tooLarge, carry | tooLarge | tooLarge1000,
+                carry | tooLarge | tooLarge1000, carry | tooLarge | tooLarge1000, carry | tooLarge | tooLarge1000, carry | tooLarge | tooLarge1000,
+                carry | tooLarge | tooLarge1000, carry | tooLarge | tooLarge1000, carry | tooLarge | tooLarge1000, carry | tooLarge | tooLarge1000 | surrogate,
+                carry | tooLarge | tooLarge1000, carry | tooLarge | tooLarge1000);
+            const ::std::int8_t cont8 = tooLong | overlong2 | twoConts | overlong3 | tooLarge1000 | overlong4;
+            const ::std::int8_t cont9 = tooLong | overlong2 | twoConts | overlong3 | tooLarge;
+            const ::std::int8_t contAB = tooLong | overlong2 | twoConts | surrogate | tooLarge;
+            const __m256i byte2High = _mm256_setr_epi8(
+                tooShort, tooShort, tooShort, tooShort, tooShort, tooShort, tooShort, tooShort, cont8, cont9, contAB, contAB, tooShort, tooShort, tooShort, tooShort,
+                tooShort, tooShort, tooShort, tooShort, tooShort, tooShort, tooShort, tooShort, cont8, cont9, contAB, contAB, tooShort, tooShort, tooShort, tooShort);
+            const __m256i incompleteLimit = _mm256_setr_epi8( // above it the last bytes begin a sequence not finished in the block
+                -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+                -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, static_cast<char>(0xF0 - 1), static_cast<char>(0xE0 - 1), static_cast<char>(0xC0 - 1));
+            const __m256i nibble = _mm256_set1_epi8(0x0F);
+            const char* const b = p;
+            __m256i error = _mm256_setzero_si256();
+            __m256i previous = _mm256_setzero_si256();
+            __m256i previousIncomplete = _mm256_setzero_si256();
+            for (; e - p >= 32; p += 32) {
+                const __m256i input = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+                if (_mm256_movemask_epi8(input) == 0) {
+                    error = _mm256_or_si256(error, previousIncomplete);
+                    previousIncomplete = _mm256_setzero_si256();
+                } else {
+                    const __m256i shifted = _mm256_permute2x128_si256(previous, input, 0x21); // high half of previous, low half of input
+                    const __m256i previous1 = _mm256_alignr_epi8(input, shifted, 15);
+                    const __m256i previous2 = _mm256_alignr_epi8(input, shifted, 14);
+                    const __m256i previous3 = _mm256_alignr_epi8(input, shifted, 13);
+                    const __m256i special = _mm256_and_si256(_mm256_and_si256(
+                        _mm256_shuffle_epi8(byte1High, _mm256_and_si256(_mm256_srli_epi16(previous1, 4), nibble)),
+                        _mm256_shuffle_epi8(byte1Low, _mm256_and_si256(previous1, nibble))),
+                        _mm256_shuffle_epi8(byte2High, _mm256_and_si256(_mm256_srli_epi16(input, 4), nibble)));
+                    const __m256i third = _mm256_subs_epu8(previous2, _mm256_set1_epi8(static_cast<char>(0xE0 - 0x80))); // 111_____ two bytes before
+                    const __m256i fourth = _mm256_subs_epu8(previous3, _mm256_set1_epi8(static_cast<char>(0xF0 - 0x80))); // 1111____ three bytes before
+                    const __m256i continuation = _mm256_and_si256(_mm256_or_si256(third, fourth), _mm256_set1_epi8(static_cast<char>(0x80)));
+                    error = _mm256_or_si256(error, _mm256_xor_si256(continuation, special));
+                    previousIncomplete = _mm256_subs_epu8(input, incompleteLimit);
+                }
+                previous = input;
+            }
+            if (!_mm256_testz_si256(error, error))
+                return find_invalid_utf8_sse2(b, e);
+            const char* restart = p; // a sequence may go on past the blocks, the tail is checked from its lead
+            for (const char* i = p; (i != b) && (p - i < 3);) {
+                const unsigned char c = static_cast<unsigned char>(*--i);
+                if ((c & 0xC0) != 0x80) {
+                    if (c >= 0xC0)
+                        restart = i;
+                    break;
+                }
+            }
+            return find_invalid_utf8_sse2(restart, e);
+        }
+#endif
+        /// @brief The best kernels supported by the CPU, selected once.
+        struct kernels final {
+            const char* (*skip_spaces)(const char*, const char*, JUJSON_SIZE_TYPE&, const char*&);
+            const char* (*find_string_special)(const char*, const char*);
+            const char* (*skip_digits)(const char*, const char*);
+            const char* (*find_invalid_utf8)(const char*, const char*);
+        };
+        inline kernels detect_kernels() noexcept {
+#if (JUJSON_HAS_AVX2_DISPATCH)
+            if (__builtin_cpu_supports("avx2")) {
+                const kernels result = {&skip_spaces_avx2, &find_string_special_avx2, &skip_digits_avx2, &find_invalid_utf8_avx2};
+                return result;
+            }
+#endif
+#if (JUJSON_HAS_SSE2)
+            const kernels result = {&skip_spaces_sse2, &find_string_special_sse2, &skip_digits_sse2, &find_invalid_utf8_sse2};
+#else
+            const kernels result = {&skip_spaces_scalar, &find_string_special_scalar, &skip_digits_scalar, &find_invalid_utf8_scalar};
+#endif
+            return result;
+        }
+        /// @brief Gets the kernels for the current CPU. @return A reference to the kernels.
+        inline const kernels& get_kernels() noexcept {
+            static const kernels result = detect_kernels();
+            return result;
+        }
+        /// @brief True for iterators over contiguous char storage the kernels can scan.
+        template<class IteratorT_>
+        struct is_contiguous_char_iterator : ::std::integral_constant<bool,
+            ::std::is_same<IteratorT_, const char*>::value ||
+            ::std::is_same<IteratorT_, char*>::value ||
+            ::std::is_same<IteratorT_, ::std::string::const_iterator>::value ||
+            ::std::is_same<IteratorT_, ::std::string::iterator>::value ||
+            ::std::is_same<IteratorT_, typename ::std::vector<char>::const_iterator>::value ||
+            ::std::is_same<IteratorT_, typename ::std::vector<char>::iterator>::value
+#if (JUJSON_HAS_STRING_VIEW)
+            || ::std::is_same<IteratorT_, ::std::string_view::const_iterator>::value
+#endif
+#if (JUJSON_HAS_MEMORY_RESOURCE)
+            || ::std::is_same<IteratorT_, ::std::pmr::string::const_iterator>::value
+#endif
+        > {};
+    }
+    /// @brief True for iterators over contiguous wchar_t storage, scanned with wmemchr.
+    template<class IteratorT_>
+    struct is_contiguous_wchar_iterator : ::std::integral_constant<bool,
+        ::std::is_same<IteratorT_, const wchar_t*>::value ||
+        ::std::is_same<IteratorT_, wchar_t*>::value ||
+        ::std::is_same<IteratorT_, ::std::wstring::const_iterator>::value ||
+        ::std::is_same<IteratorT_, ::std::wstring::iterator>::value
+#if (JUJSON_HAS_STRING_VIEW)
+        || ::std::is_same<IteratorT_, ::std::wstring_view::const_iterator>::value
+#endif
+    > {};
+    /// @brief Finds the next escape of string litteral content, memchr or wmemchr on contiguous storage. @param b the beginning iterator. @param e the ending iterator. @return The found escape, or e.
+    template<class JSONTraitsT_, class IteratorT_>
+    IteratorT_ find_json_escape(IteratorT_ b, IteratorT_ e, ::std::true_type) {
+        typedef typename JSONTraitsT_::char_type char_type;
+        if (b == e)
+            return e;
+        const char_type* const p = &*b;
+        const char_type* const q = ::std::char_traits<char_type>::find(p, static_cast<::std::size_t>(e - b), static_cast<char_type>('\\'));
+        return (q != nullptr) ? b + (q - p) : e;
+    }
+    /// @brief Finds the next escape of string litteral content. @param b the beginning iterator. @param e the ending iterator. @return The found escape, or e.
+    template<class JSONTraitsT_, class IteratorT_>
+    IteratorT_ find_json_escape(IteratorT_ b, IteratorT_ e, ::std::false_type) {
+        for (; (b != e) && !JSONTraitsT_::is_escape_spec(*b); ++b) {
+
+        }
+        return b;
+    }
+    /**
+     * @brief Decodes escape sequences of string litteral content (without delimiters), including \\uXXXX surrogate pairs.
+     *        Runs without escapes are appended at once. Malformed escapes are copied as is.
+     * @tparam OutStringT_ the type of the result string.
+     * @tparam JSONTraitsT_ the traits class used to define JSON-specific characteristics.
+     * @param b the beginning iterator. @param e the ending iterator.
+     * @return the decoded string.
+     */
+    template<class OutStringT_, class JSONTraitsT_, class IteratorT_>
+    [[nodiscard]] OutStringT_ unescape_json_string(IteratorT_ b, IteratorT_ e) {
+        typedef typename OutStringT_::value_type char_type;
+        typedef ::std::integral_constant<bool, (::std::is_same<JSONTraitsT_, default_json_traits<char>>::value && simd::is_contiguous_char_iterator<IteratorT_>::value) ||
+            (::std::is_same<JSONTraitsT_, default_json_traits<wchar_t>>::value && is_contiguous_wchar_iterator<IteratorT_>::value)> memchr_scan;
+        OutStringT_ result;
+        result.reserve(static_cast<typename OutStringT_::size_type>(::std::distance(b, e))); // decoding never grows the content
+        while (b != e) {
+            const IteratorT_ escapeBegin = find_json_escape<JSONTraitsT_>(b, e, memchr_scan());
+            result.append(b, escapeBegin);
+            b = escapeBegin;
+            if (b == e)
+                break;
+            const auto val = *b;
+            ++b;
+            if (b == e) {
+                result += static_cast<char_type>(val);
+                break;
+            }
+            const auto spec = *b;
+            ++b;
+            switch (spec) {
+            case 'b': result += static_cast<char_type>('\b'); break;
+            case 'f': result += static_cast<char_type>('\f'); break;
+            case 'n': result += static_cast<char_type>('\n'); break;
+            case 'r': result += static_cast<char_type>('\r'); break;
+            case 't': result += static_cast<char_type>('\t'); break;
+            case 'u': {
+                char32_t cp = 0;
+                if (!read_hex4(b, e, cp)) {
+                    result.append(escapeBegin, b);
+                    break;
+                }
+                if ((cp >= 0xD800) && (cp < 0xDC00)) { // high surrogate, low one expected
+                    IteratorT_ low = b;
+                    char32_t lowCp = 0;
+                    if ((low != e) && JSONTraitsT_::is_escape_spec(*low) && (++low != e) && (*low == 'u') && read_hex4(++low, e, lowCp) && (lowCp >= 0xDC00) && (lowCp < 0xE000)) {
+                        cp = 0x10000 + ((cp - 0xD800) << 10) + (lowCp - 0xDC00);
+                        b = low;
+                    }
+                }
+                append_code_point(result, cp);
+                break;
+            }
+            default: // \" \\ \/ and custom delimiters
+                result += static_cast<char_type>(spec);
+                break;
+            }
+        }
+        return result;
+    }
+    /// @brief Finds an invalid code unit with the UTF-8 kernel. @param b the beginning iterator. @param e the ending iterator. @return The found code unit, or e.
+    template<class IteratorT_>
+    IteratorT_ find_invalid_encoding(IteratorT_ b, IteratorT_ e, ::std::integral_constant<int, 0>) {
+        if (b == e)
+            return e;
+        const char* const p = &*b;
+        return b + (simd::get_kernels().find_invalid_utf8(p, p + (e - b)) - p);
+    }
+    /// @brief Finds an invalid UTF-8 code unit. @param b the beginning iterator. @param e the ending iterator. @return The found code unit, or e.
+    template<class IteratorT_>
+    IteratorT_ find_invalid_encoding(IteratorT_ b, IteratorT_ e, ::std::integral_constant<int, 1>) {
+        return encoding::find_invalid_utf8(b, e);
+    }
+    /// @brief Finds an invalid UTF-16 code unit. @param b the beginning iterator. @param e the ending iterator. @return The found code unit, or e.
+    template<class IteratorT_>
+    IteratorT_ find_invalid_encoding(IteratorT_ b, IteratorT_ e, ::std::integral_constant<int, 2>) {
+        return encoding::find_invalid_utf16(b, e);
+    }
+    /// @brief Finds an invalid UTF-32 code unit. @param b the beginning iterator. @param e the ending iterator. @return The found code unit, or e.
+    template<class IteratorT_>
+    IteratorT_ find_invalid_encoding(IteratorT_ b, IteratorT_ e, ::std::integral_constant<int, 4>) {
+        return encoding::find_invalid_utf32(b, e);
+    }
+    /**
+     * @brief Finds the first code unit of invalid encoding, the encoding being UTF-8, UTF-16 or UTF-32 by the size of the code units.
+     *        Contiguous char storage is checked 32 or 16 bytes at a time.
+     * @param b the beginning iterator. @param e the ending iterator.
+     * @return The found code unit, or e if the text is valid.
+     */
+    template<class IteratorT_>
+    [[nodiscard]] IteratorT_ find_invalid_encoding(IteratorT_ b, IteratorT_ e) {
+        typedef typename ::std::iterator_traits<IteratorT_>::value_type char_type;
+        static_assert((sizeof(char_type) == 1) || (sizeof(char_type) == 2) || (sizeof(char_type) == 4), "code units of 1, 2 or 4 bytes expected");
+        return find_invalid_encoding(b, e, ::std::integral_constant<int, simd::is_contiguous_char_iterator<IteratorT_>::value ? 0 : static_cast<int>(sizeof(char_type))>());
+    }
+    namespace parallel {
+        /// @brief Gets the number of threads to use. @param threads the requested number, all hardware threads if 0. @return The number of threads, at least 1.
+        inline unsigned thread_count(unsigned threads) {
+#if (!(defined JUJSON_NO_THREADS))
+            return (threads != 0) ? threads : (::std::max)(1u, ::std::thread::hardware_concurrency());
+#else
+            (void)threads;
+            return 1;
+#endif
+        }
+        /**
+         * @brief Calls function(block) for every block in [0, blocks) on up to threads threads, the calling thread included.
+         *        Threads take the next block from a shared counter as they finish the previous one, so uneven blocks balance out.
+         *        The first exception thrown by function is rethrown on the calling thread, remaining blocks are skipped.
+         * @param blocks the number of blocks. @param threads the number of threads, all hardware threads if 0. @param function the block function.
+         */
+        template<class FunctionT_>
+        void for_each_block(::std::size_t blocks, unsigned threads, FunctionT_ function) {
+#if (!(defined JUJSON_NO_THREADS))
+            threads = static_cast<unsigned>((::std::min)(static_cast<::std::size_t>(thread_count(threads)), blocks));
+            ::std::atomic<::std::size_t> nextBlock(0);
+            JUJSON_DEFAULT_CONTAINER<::std::exception_ptr> errors(threads + 1);
+            auto work = [&](unsigned worker) {
+                try {
+                    for (;;) {
+                        const ::std::size_t block = nextBlock.fetch_add(1, ::std::memory_order_relaxed);
+                        if (block >= blocks)
+                            return;
+                        function(block);
+                    }
+                } catch (...) {
+                    errors[worker] = ::std::current_exception();
+                    nextBlock = blocks;
+                }
+            };
+            JUJSON_DEFAULT_CONTAINER<::std::thread> workers;
+            for (unsigned i = 1; i < threads; ++i) { // the calling thread is the first worker
+                try {
+                    workers.push_back(::std::thread(work, i));
+                } catch (...) { // continue with less threads
+                    break;
+                }
+            }
+            work(0);
+            for (auto& worker : workers)
+                worker.join();
+            for (const auto& error : errors) {
+                if (error)
+                    ::std::rethrow_exception(error);
+            }
+#else
+            (void)threads;
+            for (::std::size_t block = 0; block < blocks; ++block)
+                function(block);
+#endif
+        }
+    }
+    /**
+     * @brief Read-only contents of a file for parsing without copying it into a string.
+     *        Regular files are memory-mapped with a sequential access hint; pipes, character devices and systems without mmap
+     *        are read into an owned buffer instead. The contents are valid as long as the object lives.
+     */
+    struct json_mapped_file final {
+        private:
+        const char* data_;
+        ::std::size_t size_;
+        bool mapped_;
+        bool open_;
+        JUJSON_DEFAULT_CONTAINER<char> buffer_; // contents when not mapped
+
+        public:
+        /// @brief Constructs a closed json_mapped_file object.
+        json_mapped_file() noexcept : data_(nullptr), size_(0), mapped_(false), open_(false) {
+
+        }
+        /// @brief Opens and maps, or reads, a file. @param path the path of the file. @param map false to always read the file into a buffer.
+        explicit json_mapped_file(const char* path, bool map = true) : json_mapped_file() {
+            open(path, map);
+        }
+        /// @brief Opens and maps, or reads, a file. @param path the path of the file. @param map false to always read the file into a buffer.
+        explicit json_mapped_file(const ::std::string& path, bool map = true) : json_mapped_file() {
+            open(path.c_str(), map);
+        }
+        json_mapped_file(const json_mapped_file&) = delete;
+        json_mapped_file& operator=(const json_mapped_file&) = delete;
+        json_mapped_file(json_mapped_file&& other) noexcept : data_(other.data_), size_(other.size_), mapped_(other.mapped_), open_(other.open_), buffer_(::std::move(other.buffer_)) {
+            other.data_ = nullptr;
+            other.size_ = 0;
+            other.mapped_ = false;
+            other.open_ = false;
+        }
+        json_mapped_file& operator=(json_mapped_file&& other) noexcept {
+            if (this != &other) {
+                close();
+                data_ = other.data_;
+                size_ = other.size_;
+                mapped_ = other.mapped_;
+                open_ = other.open_;
+                buffer_ = ::std::move(other.buffer_);
+                other.data_ = nullptr;
+                other.size_ = 0;
+                other.mapped_ = false;
+                other.open_ = false;
+            }
+            return *this;
+        }
+        ~json_mapped_file() {
+            close();
+        }
+
+        public:
+        /**
+         * @brief Opens and maps, or reads, a file, closing the previous one.
+         * @param path the path of the file. @param map false to always read the file into a buffer.
+         * @return true if the file could be opened and read, false otherwise.
+         */
+        bool open(const char* path, bool map = true) {
+            close();
+#if (JUJSON_HAS_MMAP)
+            int fd = -1;
+            do {
+                fd = ::open(path, O_RDONLY);
+            } while ((fd < 0) && (errno == EINTR));
+            if (fd < 0)
+                return false;
+            struct stat status;
+            if (map && (::fstat(fd, &status) == 0) && S_ISREG(status.st_mode) && (status.st_size > 0) &&
+                (static_cast<::std::size_t>(status.st_size) == static_cast<unsigned long long>(status.st_size))) {
+                void* mapping = ::mmap(nullptr, static_cast<::std::size_t>(status.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+                if (mapping != MAP_FAILED) {
+#   if (defined MADV_SEQUENTIAL)
+                    ::madvise(mapping, static_cast<::std::size_t>(status.st_size), MADV_SEQUENTIAL);
+#   endif
+                    ::close(fd);
+                    data_ = static_cast<const char*>(mapping);
+                    size_ = static_cast<::std::size_t>(status.st_size);
+                    mapped_ = true;
+                    open_ = true;
+                    return true;
+                }
+            }
+            // empty files, pipes, devices or failed mapping: read until the end.
+            ::std::size_t size = 0;
+            for (;;) {
+                if (buffer_.size() - size < 64 * 1024)
+                    buffer_.resize((::std::max)(buffer_.size() * 2, static_cast<::std::size_t>(64 * 1024)));
+                const ssize_t count = ::read(fd, buffer_.data() + size, buffer_.size() - size);
+                if (count > 0) {
+                    size += static_cast<::std::size_t>(count);
+                } else if (count == 0) {
+                    break;
+                } else if (errno != EINTR) {
+                    ::close(fd);
+                    buffer_ = JUJSON_DEFAULT_CONTAINER<char>();
+                    return false;
+                }
+            }
+            ::close(fd);
+#else
+            (void)map;
+            ::std::FILE* file = ::std::fopen(path, "rb");
+            if (file == nullptr)
+                return false;
+            ::std::size_t size = 0;
+            for (;;) {
+                if (buffer_.size() - size < 64 * 1024)
+                    buffer_.resize((::std::max)(buffer_.size() * 2, static_cast<::std::size_t>(64 * 1024)));
+                const ::std::size_t count = ::std::fread(buffer_.data() + size, 1, buffer_.size() - size, file);
+                size += count;
+                if (count == 0)
+                    break;
+            }
+            const bool failed = (::std::ferror(file) != 0);
+            ::std::fclose(file);
+            if (failed) {
+                buffer_ = JUJSON_DEFAULT_CONTAINER<char>();
+                return false;
+            }
+#endif
+            buffer_.resize(size);
+            buffer_.shrink_to_fit();
+            data_ = buffer_.data();
+            size_ = size;
+            open_ = true;
+            return true;
+        }
+        /// @brief Unmaps or releases the contents.
+        void close() noexcept {
+#if (JUJSON_HAS_MMAP)
+            if (mapped_)
+                ::munmap(const_cast<char*>(data_), size_);
+#endif
+            buffer_ = JUJSON_DEFAULT_CONTAINER<char>();
+            data_ = nullptr;
+            size_ = 0;
+            mapped_ = false;
+            open_ = false;
+        }
+        /// @brief Checks if the file was opened and read. @return true if the contents are available, false otherwise.
+        [[nodiscard]] bool is_open() const noexcept {
+            return open_;
+        }
+        /// @brief Checks if the contents are memory-mapped. @return true if mapped, false if read into a buffer.
+        [[nodiscard]] bool is_mapped() const noexcept {
+            return mapped_;
+        }
+        /// @brief Gets the contents. @return The first character of the contents.
+        [[nodiscard]] const char* data() const noexcept {
+            return data_;
+        }
+        /// @brief Gets the size of the contents. @return The size in bytes.
+        [[nodiscard]] ::std::size_t size() const noexcept {
+            return size_;
+        }
+        [[nodiscard]] const char* begin() const noexcept {
+            return data_;
+        }
+        [[nodiscard]] const char* end() const noexcept {
+            return data_ + size_;
+        }
+#if (JUJSON_HAS_STRING_VIEW)
+        /// @brief Gets the contents as a view, to parse with json_parser<std::string_view> directly over the mapping. @return The contents.
+        [[nodiscard]] ::std::string_view view() const noexcept {
+            return ::std::string_view(data_, size_);
+        }
+#endif
+    };
+    namespace binding {
+        void jujson_bind_fields(); // the name for lookup, members are found by ADL
+
+        enum category {
+            category_none,
+            category_bool,
+            category_integer,
+            category_floating,
+            category_string,
+            category_array,
+            category_object, // JUJSON_BIND
+        };
+        struct field_probe {
+            template<class MemberPointerT_, MemberPointerT_> void field(const char*) {}
+        };
+        template<class T>
+        struct is_bound final {
+            private:
+            template<class U> static ::std::true_type test(decltype(jujson_bind_fields(static_cast<const U*>(nullptr), ::std::declval<field_probe&>()))*);
+            template<class> static ::std::false_type test(...);
+
+            public:
+            static const bool value = decltype(test<T>(nullptr))::value;
+        };
+        template<class T>
+        struct category_of : ::std::integral_constant<category,
+            ::std::is_same<T, bool>::value ? category_bool :
+            ::std::is_integral<T>::value ? category_integer :
+            ::std::is_floating_point<T>::value ? category_floating :
+            is_bound<T>::value ? category_object : category_none> {};
+        template<class CharT_, class CharTraitsT_, class AllocatorT_>
+        struct category_of<::std::basic_string<CharT_, CharTraitsT_, AllocatorT_>> : ::std::integral_constant<category, category_string> {};
+        template<class T, class AllocatorT_>
+        struct category_of<::std::vector<T, AllocatorT_>> : ::std::integral_constant<category, category_array> {};
+        template<class T> struct back_element; // the last element of an array whose elements have no address, as in std::vector<bool>
+        template<class MemberPointerT_> struct member_of;
+        template<class T, class M>
+        struct member_of<M T::*> {
+            typedef T object_type;
+            typedef M member_type;
+        };
+
+        /// @brief Type-erased conversions of parsed values to one bound type, see json_bind_handler.
+        template<class IteratorT_, class JSONTraitsT_>
+        struct operations {
+            json_value_kind container; // JUSJON_JSON_VALUE_ARRAY or JUSJON_JSON_VALUE_OBJECT, JUSJON_JSON_VALUE_INVALID for scalars
+            bool (*scalar)(void* target, json_value_kind kind, IteratorT_ b, IteratorT_ e); // false if the value does not fit
+            void (*begin)(void* target); // an array or object starts
+            void* (*element)(void* target, const operations*& elementOperations); // appends an array element
+            void* (*member)(void* target, IteratorT_ b, IteratorT_ e, const operations*& memberOperations); // nullptr for unknown keys
+        };
+        template<class T, class IteratorT_, class JSONTraitsT_> const operations<IteratorT_, JSONTraitsT_>* operations_of();
+
+        template<class T, class IteratorT_, class JSONTraitsT_>
+        bool convert(T& target, json_value_kind kind, IteratorT_ b, IteratorT_ e, ::std::integral_constant<category, category_bool>) {
+            if ((kind != JUSJON_JSON_VALUE_TRUE) && (kind != JUSJON_JSON_VALUE_FALSE))
+                return false;
+            target = (kind == JUSJON_JSON_VALUE_TRUE);
+            (void)b;
+            (void)e;
+            return true;
+        }
+        template<class T, class IteratorT_, class JSONTraitsT_>
+        bool convert(T& target, json_value_kind kind, IteratorT_ b, IteratorT_ e, ::std::integral_constant<category, category_integer>) {
+            if (kind != JUSJON_JSON_VALUE_NUMBER)
+                return false;
+            const json_number number = decode_json_number<JSONTraitsT_>(b, e);
+            if (number.kind == JUJSON_NUMBER_KIND_INT64) {
+                if ((number.i < 0) ? (!::std::is_signed<T>::value || (number.i < static_cast<::std::int64_t>((::std::numeric_limits<T>::min)()))) :
+                    (static_cast<::std::uint64_t>(number.i) > static_cast<::std::uint64_t>((::std::numeric_limits<T>::max)())))
+                    return false;
+                target = static_cast<T>(number.i);
+                return true;
+            }
+            if ((number.kind != JUJSON_NUMBER_KIND_UINT64) || (number.u > static_cast<::std::uint64_t>((::std::numeric_limits<T>::max)())))
+                return false;
+            target = static_cast<T>(number.u);
+            return true;
+        }
+        template<class T, class IteratorT_, class JSONTraitsT_>
+        bool convert(T& target, json_value_kind kind, IteratorT_ b, IteratorT_ e, ::std::integral_constant<category, category_floating>) {
+            if (kind != JUSJON_JSON_VALUE_NUMBER)
+                return false;
+            target = static_cast<T>(decode_json_number<JSONTraitsT_>(b, e).as_double());
+            return true;
+        }
+        template<class T, class IteratorT_, class JSONTraitsT_>
+        bool convert(T& target, json_value_kind kind, IteratorT_ b, IteratorT_ e, ::std::integral_constant<category, category_string>) {
+            if (kind != JUSJON_JSON_VALUE_STRING)
+                return false;
+            target = unescape_json_string<T, JSONTraitsT_>(b, e);
+            return true;
+        }
+        template<class T, class IteratorT_, class JSONTraitsT_, category CategoryT_>
+        bool convert(T&, json_value_kind, IteratorT_, IteratorT_, ::std::integral_constant<category, CategoryT_>) { // arrays and objects
+            return false;
+        }
+        template<class T, class IteratorT_, class JSONTraitsT_>
+        bool scalar(void* target, json_value_kind kind, IteratorT_ b, IteratorT_ e) {
+            if (kind == JUSJON_JSON_VALUE_NULL) // leaves the member as it is
+                return true;
+            return convert<T, IteratorT_, JSONTraitsT_>(*static_cast<T*>(target), kind, b, e, category_of<T>());
+        }
+        template<class T>
+        void begin(void* target) {
+            (void)target;
+        }
+        template<class T>
+        void begin_array(void* target) {
+            static_cast<T*>(target)->clear();
+        }
+        template<class T, class IteratorT_, class JSONTraitsT_>
+        void* element(void* target, const operations<IteratorT_, JSONTraitsT_>*& elementOperations, ::std::true_type) {
+            T& array = *static_cast<T*>(target);
+            array.emplace_back();
+            elementOperations = operations_of<typename T::value_type, IteratorT_, JSONTraitsT_>();
+            return &array.back();
+        }
+        template<class T, class IteratorT_, class JSONTraitsT_>
+        void* element(void* target, const operations<IteratorT_, JSONTraitsT_>*& elementOperations, ::std::false_type) { // proxy references, the array is the target
+            static_cast<T*>(target)->emplace_back();
+            elementOperations = operations_of<back_element<T>, IteratorT_, JSONTraitsT_>();
+            return target;
+        }
+        template<class T, class IteratorT_, class JSONTraitsT_>
+        void* element(void* target, const operations<IteratorT_, JSONTraitsT_>*& elementOperations) {
+            return element<T, IteratorT_, JSONTraitsT_>(target, elementOperations, ::std::is_same<typename T::reference, typename T::value_type&>());
+        }
+        template<class T, class IteratorT_, class JSONTraitsT_>
+        bool back_scalar(void* target, json_value_kind kind, IteratorT_ b, IteratorT_ e) { // target is the array
+            typedef typename T::value_type value_type;
+            if (kind == JUSJON_JSON_VALUE_NULL) // leaves the element as constructed
+                return true;
+            value_type value = value_type();
+            if (!convert<value_type, IteratorT_, JSONTraitsT_>(value, kind, b, e, category_of<value_type>()))
+                return false;
+            static_cast<T*>(target)->back() = value;
+            return true;
+        }
+        template<class T, class IteratorT_, class JSONTraitsT_>
+        void* no_element(void*, const operations<IteratorT_, JSONTraitsT_>*&) {
+            return nullptr;
+        }
+        template<class T, class MemberPointerT_, MemberPointerT_ MemberT_>
+        void* access(void* target) {
+            return &(static_cast<T*>(target)->*MemberT_);
+        }
+
+        /**
+         * @brief Members of a JUJSON_BIND type by key, built once per type. Keys are hashed from their length, first and last character
+         *        with a multiplier chosen so that keys get distinct slots when possible, colliding keys are probed linearly.
+         */
+        template<class T, class IteratorT_, class JSONTraitsT_>
+        struct field_table final {
+            public:
+            typedef typename ::std::iterator_traits<IteratorT_>::value_type char_type;
+            typedef operations<IteratorT_, JSONTraitsT_> operations_type;
+            struct entry {
+                ::std::basic_string<char_type> key;
+                void* (*access)(void*);
+                const operations_type* (*operations)(); // called on use, so that types can refer to themselves
+            };
+
+            private:
+            JUJSON_DEFAULT_CONTAINER<entry> fields_;
+            JUJSON_DEFAULT_CONTAINER<JUJSON_SIZE_TYPE> slots_; // field position + 1, 0 for an empty slot
+            ::std::uint32_t multiplier_;
+
+            struct collector {
+                JUJSON_DEFAULT_CONTAINER<entry>& fields;
+
+                template<class MemberPointerT_, MemberPointerT_ MemberT_>
+                void field(const char* name) {
+                    entry result;
+                    for (; *name != '\0'; ++name)
+                        result.key.push_back(static_cast<char_type>(*name));
+                    result.access = &access<T, MemberPointerT_, MemberT_>;
+                    result.operations = &operations_of<typename member_of<MemberPointerT_>::member_type, IteratorT_, JSONTraitsT_>;
+                    fields.push_back(JUJSON_MOVE(result));
+                }
+            };
+
+            template<class KeyIteratorT_>
+            JUJSON_SIZE_TYPE slot(KeyIteratorT_ b, JUJSON_SIZE_TYPE size, ::std::uint32_t multiplier) const noexcept {
+                const ::std::uint32_t first = (size != 0) ? static_cast<::std::uint32_t>(b[0]) : 0;
+                const ::std::uint32_t last = (size != 0) ? static_cast<::std::uint32_t>(b[size - 1]) : 0;
+                const ::std::uint32_t hash = (static_cast<::std::uint32_t>(size) * 0x9E3779B1u) ^ (first * multiplier) ^ (last * (multiplier >> 3));
+                return static_cast<JUJSON_SIZE_TYPE>(hash >> 16) & (slots_.size() - 1);
+            }
+            JUJSON_SIZE_TYPE fill(::std::uint32_t multiplier) { // returns the number of collisions
+                ::std::fill(slots_.begin(), slots_.end(), 0);
+                JUJSON_SIZE_TYPE collisions = 0;
+                for (JUJSON_SIZE_TYPE position = 0; position < fields_.size(); ++position) {
+                    JUJSON_SIZE_TYPE s = slot(fields_[position].key.begin(), static_cast<JUJSON_SIZE_TYPE>(fields_[position].key.size()), multiplier);
+                    for (; slots_[s] != 0; s = (s + 1) & (slots_.size() - 1))
+                        ++collisions;
+                    slots_[s] = position + 1;
+                }
+                return collisions;
+            }
+
+            public:
+            field_table() : fields_(), slots_(), multiplier_(0) {
+                collector visitor = {fields_};
+                jujson_bind_fields(static_cast<const T*>(nullptr), visitor);
+                JUJSON_SIZE_TYPE slotCount = 2;
+                while (slotCount < fields_.size() * 2)
+                    slotCount <<= 1;
+                slots_.resize(slotCount);
+                JUJSON_SIZE_TYPE fewest = static_cast<JUJSON_SIZE_TYPE>(-1);
+                for (::std::uint32_t multiplier = 0x01000193u; (fewest != 0) && (multiplier < 0x01000193u + 2 * 256); multiplier += 2) {
+                    const JUJSON_SIZE_TYPE collisions = fill(multiplier);
+                    if (collisions < fewest) {
+                        fewest = collisions;
+                        multiplier_ = multiplier;
+                    }
+                }
+                fill(multiplier_);
+            }
+            /// @brief Gets the table of T. @return The table, built on the first call.
+            static const field_table& get() {
+                static const field_table table;
+                return table;
+            }
+            /// @brief Finds a member by key. @param b the key begin. @param size the key size. @return The member, nullptr if not found.
+            template<class KeyIteratorT_>
+            const entry* find(KeyIteratorT_ b, JUJSON_SIZE_TYPE size) const {
+                for (JUJSON_SIZE_TYPE s = slot(b, size, multiplier_); slots_[s] != 0; s = (s + 1) & (slots_.size() - 1)) {
+                    const entry& f = fields_[slots_[s] - 1];
+                    if ((static_cast<JUJSON_SIZE_TYPE>(f.key.size()) == size) && ::std::equal(f.key.begin(), f.key.end(), b))
+                        return &f;
+                }
+                return nullptr;
+            }
+        };
+        template<class T, class IteratorT_, class JSONTraitsT_>
+        void* member(void* target, IteratorT_ b, IteratorT_ e, const operations<IteratorT_, JSONTraitsT_>*& memberOperations) {
+            typedef field_table<T, IteratorT_, JSONTraitsT_> table_type;
+            const table_type& table = table_type::get();
+            const typename table_type::entry* f = table.find(b, static_cast<JUJSON_SIZE_TYPE>(e - b));
+            if (f == nullptr) {
+                bool escaped = false;
+                for (IteratorT_ i = b; !escaped && (i != e); ++i)
+                    escaped = JSONTraitsT_::is_escape_spec(*i);
+                if (!escaped)
+                    return nullptr;
+                const ::std::basic_string<typename table_type::char_type> key = unescape_json_string<::std::basic_string<typename table_type::char_type>, JSONTraitsT_>(b, e);
+                f = table.find(key.begin(), static_cast<JUJSON_SIZE_TYPE>(key.size()));
+                if (f == nullptr)
+                    return nullptr;
+            }
+            memberOperations = f->operations();
+            return f->access(target);
+        }
+        template<class T, class IteratorT_, class JSONTraitsT_>
+        void* no_member(void*, IteratorT_, IteratorT_, const operations<IteratorT_, JSONTraitsT_>*&) {
+            return nullptr;
+        }
+        template<class T, class IteratorT_, class JSONTraitsT_, category CategoryT_ = category_of<T>::value>
+        struct operations_table final { // scalars
+            static const operations<IteratorT_, JSONTraitsT_>* get() {
+                static const operations<IteratorT_, JSONTraitsT_> result = {JUSJON_JSON_VALUE_INVALID, &scalar<T, IteratorT_, JSONTraitsT_>, &begin<T>,
+                    &no_element<T, IteratorT_, JSONTraitsT_>, &no_member<T, IteratorT_, JSONTraitsT_>};
+                return &result;
+            }
+        };
+        template<class T, class IteratorT_, class JSONTraitsT_>
+        struct operations_table<T, IteratorT_, JSONTraitsT_, category_array> final {
+            static const operations<IteratorT_, JSONTraitsT_>* get() {
+                static const operations<IteratorT_, JSONTraitsT_> result = {JUSJON_JSON_VALUE_ARRAY, &scalar<T, IteratorT_, JSONTraitsT_>, &begin_array<T>,
+                    &element<T, IteratorT_, JSONTraitsT_>, &no_member<T, IteratorT_, JSONTraitsT_>};
+                return &result;
+            }
+        };
+        template<class T, class IteratorT_, class JSONTraitsT_>
+        struct operations_table<T, IteratorT_, JSONTraitsT_, category_object> final {
+            static const operations<IteratorT_, JSONTraitsT_>* get() {
+                static const operations<IteratorT_, JSONTraitsT_> result = {JUSJON_JSON_VALUE_OBJECT, &scalar<T, IteratorT_, JSONTraitsT_>, &begin<T>,
+                    &no_element<T, IteratorT_, JSONTraitsT_>, &member<T, IteratorT_, JSONTraitsT_>};
+                return &result;
+            }
+        };
+        template<class T, class IteratorT_, class JSONTraitsT_>
+        struct operations_table<back_element<T>, IteratorT_, JSONTraitsT_, category_none> final {
+            static const operations<IteratorT_, JSONTraitsT_>* get() {
+                static const operations<IteratorT_, JSONTraitsT_> result = {JUSJON_JSON_VALUE_INVALID, &back_scalar<T, IteratorT_, JSONTraitsT_>, &begin<T>,
+                    &no_element<T, IteratorT_, JSONTraitsT_>, &no_member<T, IteratorT_, JSONTraitsT_>};
+                return &result;
+            }
+        };
+        template<class T, class IteratorT_, class JSONTraitsT_>
+        struct operations_table<T, IteratorT_, JSONTraitsT_, category_none> final {
+            static_assert(sizeof(T) == 0, "jujson: the type is not bindable, use JUJSON_BIND for structs.");
+        };
+        template<class T, class IteratorT_, class JSONTraitsT_>
+        const operations<IteratorT_, JSONTraitsT_>* operations_of() {
+            return operations_table<T, IteratorT_, JSONTraitsT_>::get();
+        }
+    }
+    /**
+     * @brief Handler of json_parser::parse filling a bound object directly, without json_value: see json_parser::parse_into.
+     *        Bindable types are bool, integers, floating point numbers, std::basic_string, std::vector of bindable types (std::vector<bool> included)
+     *        and structs described with JUJSON_BIND. Unknown keys are skipped, null and missing members leave members as they are.
+     * @tparam IteratorT_ the iterator type of the parsed input.
+     * @tparam JSONTraitsT_ the traits class used to define JSON-specific characteristics.
+     */
+    template<class IteratorT_, class JSONTraitsT_ = default_json_traits<typename ::std::iterator_traits<IteratorT_>::value_type>>
+    struct json_bind_handler final {
+        private:
+        typedef binding::operations<IteratorT_, JSONTraitsT_> operations_type;
+        struct frame {
+            void* target;
+            const operations_type* operations;
+            void* next; // member of the value after the last key, nullptr to skip it
+            const operations_type* nextOperations;
+        };
+
+        private:
+        void* root_;
+        const operations_type* rootOperations_;
+        JUJSON_DEFAULT_CONTAINER<frame> frames_; // open arrays and objects
+        JUJSON_SIZE_TYPE skipDepth_; // depth in a skipped container
+        bool mismatch_;
+
+        public:
+        /// @brief Constructs a json_bind_handler object. @param object the object to fill, it must outlive the handler.
+        template<class T>
+        explicit json_bind_handler(T& object) : root_(&object), rootOperations_(binding::operations_of<T, IteratorT_, JSONTraitsT_>()), frames_(), skipDepth_(0), mismatch_(false) {
+
+        }
+
+        private:
+        // the target of the value that begins now, nullptr to skip it.
+        void* begin_value(const operations_type*& operations) {
+            if (frames_.empty()) {
+                operations = rootOperations_;
+                void* result = root_;
+                root_ = nullptr; // one value
+                return result;
+            }
+            frame& parent = frames_.back();
+            if (parent.operations->container == JUSJON_JSON_VALUE_ARRAY)
+                return parent.operations->element(parent.target, operations);
+            operations = parent.nextOperations;
+            return parent.next;
+        }
+        bool mismatch() {
+            mismatch_ = true;
+            return false;
+        }
+        bool scalar(IteratorT_ b, IteratorT_ e, json_value_kind kind) {
+            if (skipDepth_ != 0)
+                return true;
+            const operations_type* operations = nullptr;
+            void* target = begin_value(operations);
+            return (target == nullptr) || operations->scalar(target, kind, b, e) || mismatch();
+        }
+        bool open_container(json_value_kind kind) {
+            if (skipDepth_ != 0) {
+                ++skipDepth_;
+                return true;
+            }
+            const operations_type* operations = nullptr;
+            void* target = begin_value(operations);
+            if (target == nullptr) {
+                skipDepth_ = 1;
+                return true;
+            }
+            if (operations->container != kind)
+                return mismatch();
+            operations->begin(target);
+            frame f = {target, operations, nullptr, nullptr};
+            frames_.push_back(f);
+            return true;
+        }
+        bool close_container() {
+            if (skipDepth_ != 0)
+                --skipDepth_;
+            else
+                frames_.pop_back();
+            return true;
+        }
+
+        public:
+        bool on_null(IteratorT_ b, IteratorT_ e)        {return scalar(b, e, JUSJON_JSON_VALUE_NULL);}
+        bool on_true(IteratorT_ b, IteratorT_ e)        {return scalar(b, e, JUSJON_JSON_VALUE_TRUE);}
+        bool on_false(IteratorT_ b, IteratorT_ e)       {return scalar(b, e, JUSJON_JSON_VALUE_FALSE);}
+        bool on_number(IteratorT_ b, IteratorT_ e)      {return scalar(b, e, JUSJON_JSON_VALUE_NUMBER);}
+        bool on_string(IteratorT_ b, IteratorT_ e)      {return scalar(b, e, JUSJON_JSON_VALUE_STRING);}
+        bool on_key(IteratorT_ b, IteratorT_ e) {
+            if (skipDepth_ == 0) {
+                frame& parent = frames_.back();
+                parent.next = parent.operations->member(parent.target, b, e, parent.nextOperations);
+            }
+            return true;
+        }
+        bool on_array_begin(IteratorT_)                 {return open_container(JUSJON_JSON_VALUE_ARRAY);}
+        bool on_array_end(IteratorT_)                   {return close_container();}
+        bool on_object_begin(IteratorT_)                {return open_container(JUSJON_JSON_VALUE_OBJECT);}
+        bool on_object_end(IteratorT_)                  {return close_container();}
+        /// @brief Checks if parsing stopped because a value did not fit its member. @return True on a type mismatch.
+        [[nodiscard]] bool is_mismatch() const noexcept {
+            return mismatch_;
+        }
+    };
+    /**
+     * @brief Sink of json_writer appending to a string.
+     * @tparam StringT_ the type of the string.
+     */
+    template<class StringT_>
+    struct json_string_sink final {
+        public:
+        typedef typename StringT_::value_type char_type;
+
+        private:
+        StringT_& str_;
+
+        public:
+        /// @brief Constructs a json_string_sink object. @param str the string to append to, reserve json_writer::size for one allocation.
+        explicit json_string_sink(StringT_& str) : str_(str) {
+
+        }
+        void put(char_type c) {
+            str_.push_back(c);
+        }
+        void write(const char_type* data, JUJSON_SIZE_TYPE size) {
+            str_.append(data, size);
+        }
+        void flush() noexcept {
+
+        }
+    };
+    /**
+     * @brief Sink of json_writer that collects output in a fixed buffer and passes it to a callback when the buffer is full.
+     * @tparam CharT_ the character type.
+     * @tparam FlushT_ the callback type, called with (const CharT_* data, JUJSON_SIZE_TYPE size).
+     */
+    template<class CharT_, class FlushT_>
+    struct json_buffer_sink final {
+        public:
+        typedef CharT_ char_type;
+
+        private:
+        FlushT_ flush_;
+        JUJSON_DEFAULT_CONTAINER<CharT_> buffer_;
+        JUJSON_SIZE_TYPE size_;
+
+        public:
+        /// @brief Constructs a json_buffer_sink object. @param flush the callback for full buffers. @param capacity the size of the buffer.
+        explicit json_buffer_sink(FlushT_ flush, JUJSON_SIZE_TYPE capacity = 64 * 1024) : flush_(flush), buffer_((capacity != 0) ? capacity : 1), size_(0) {
+
+        }
+        void put(char_type c) {
+            if (size_ == buffer_.size())
+                flush();
+            buffer_[size_++] = c;
+        }
+        void write(const char_type* data, JUJSON_SIZE_TYPE size) {
+            if (size > buffer_.size() - size_) {
+                flush();
+                if (size >= buffer_.size()) { // bigger than the buffer, passed as is
+                    flush_(data, size);
+                    return;
+                }
+            }
+            ::std::copy(data, data + size, buffer_.begin() + size_);
+            size_ += size;
+        }
+        /// @brief Passes the buffered output to the callback.
+        void flush() {
+            if (size_ == 0)
+                return;
+            flush_(static_cast<const char_type*>(buffer_.data()), size_);
+            size_ = 0;
+        }
+    };
+    /// @brief Callback of json_buffer_sink writing to a std::basic_ostream.
+    template<class CharT_>
+    struct json_ostream_flush final {
+        public:
+        ::std::basic_ostream<CharT_>* os;
+
+        json_ostream_flush(::std::basic_ostream<CharT_>& stream) : os(&stream) {
+
+        }
+        void operator()(const CharT_* data, JUJSON_SIZE_TYPE size) {
+            os->write(data, static_cast<::std::streamsize>(size));
+        }
+    };
+    /// @brief Sink of json_writer writing to a std::basic_ostream through a buffer, constructible from the stream.
+    template<class CharT_>
+    using json_ostream_sink = json_buffer_sink<CharT_, json_ostream_flush<CharT_>>;
+    /// @brief Sink of json_writer that only counts characters, see json_writer::size.
+    template<class CharT_>
+    struct json_size_sink final {
+        public:
+        typedef CharT_ char_type;
+
+        private:
+        JUJSON_SIZE_TYPE size_;
+
+        public:
+        json_size_sink() : size_(0) {
+
+        }
+        void put(char_type) noexcept {
+            ++size_;
+        }
+        void write(const char_type*, JUJSON_SIZE_TYPE size) noexcept {
+            size_ += size;
+        }
+        void flush() noexcept {
+
+        }
+        /// @brief Gets the number of written characters. @return The number of written characters.
+        [[nodiscard]] JUJSON_SIZE_TYPE size() const noexcept {
+            return size_;
+        }
+    };
+    /// @brief Options of json_writer.
+    struct json_writer_options {
+        JUJSON_SIZE_TYPE indent; // spaces per nesting level, 0 for compact output
+        bool escapeStrings; // data of strings and keys is raw text to escape, by default it's text as in JSON input, written as is
+
+        json_writer_options() : indent(0), escapeStrings(false) {
+
+        }
+    };
+    /**
+     * @brief Writes json_value trees, or json_tape cursors, to a sink in one pass without temporary strings.
+     *        A sink has put(char_type), write(const char_type*, JUJSON_SIZE_TYPE) and flush(), see json_string_sink, json_buffer_sink, json_ostream_sink.
+     *        Strings and keys are written as they are in data(), in escaped form as parsed; numbers without text are formatted from their value.
+     * @tparam SinkT_ the sink type.
+     * @tparam JSONTraitsT_ the traits class used to define JSON-specific characteristics of the output.
+     */
+    template<class SinkT_, class JSONTraitsT_ = default_json_traits<typename SinkT_::char_type>>
+    struct json_writer final {
+        public:
+        typedef typename SinkT_::char_type char_type;
+
+        private:
+        typedef JSONTraitsT_ json_traits;
+
+        private:
+        SinkT_& sink_;
+        json_writer_options options_;
+
+        public:
+        /// @brief Constructs a json_writer object. @param sink the sink to write to. @param options the output options.
+        explicit json_writer(SinkT_& sink, const json_writer_options& options = json_writer_options()) : sink_(sink), options_(options) {
+
+        }
+
+        private:
+        template<class StringT_>
+        void write_text(const StringT_& str, ::std::true_type) { // same character type
+            sink_.write(str.data(), static_cast<JUJSON_SIZE_TYPE>(str.size()));
+        }
+        template<class StringT_>
+        void write_text(const StringT_& str, ::std::false_type) {
+            for (auto c : str)
+                sink_.put(static_cast<char_type>(c));
+        }
+        template<class StringT_>
+        void write_text(const StringT_& str) {
+            write_text(str, ::std::is_same<typename StringT_::value_type, char_type>());
+        }
+        template<class StringT_>
+        void write_string(const StringT_& str) {
+            sink_.put(json_traits::get_string_litteral_begin());
+            if (options_.escapeStrings)
+                escape(str.begin(), str.end());
+            else
+                write_text(str);
+            sink_.put(json_traits::get_string_litteral_end());
+        }
+        void write_indent(JUJSON_SIZE_TYPE depth) {
+            if (options_.indent == 0)
+                return;
+            sink_.put(static_cast<char_type>('\n'));
+            for (JUJSON_SIZE_TYPE i = depth * options_.indent; i != 0; --i)
+                sink_.put(static_cast<char_type>(' '));
+        }
+        template<class JSONValueT_>
+        void write_container(const JSONValueT_& value, JUJSON_SIZE_TYPE depth, char_type begin, char_type end) {
+            sink_.put(begin);
+            bool first = true;
+            for (const auto& child : value.get_childs()) {
+                if (!first)
+                    sink_.put(json_traits::get_comma());
+                first = false;
+                write_indent(depth + 1);
+                write_value(child, depth + 1);
+            }
+            if (!first)
+                write_indent(depth);
+            sink_.put(end);
+        }
+        template<class JSONValueT_>
+        void write_value(const JSONValueT_& value, JUJSON_SIZE_TYPE depth) {
+            switch (value.kind()) {
+            case JUSJON_JSON_VALUE_ARRAY:
+                write_container(value, depth, json_traits::get_array_begin(), json_traits::get_array_end());
+                break;
+            case JUSJON_JSON_VALUE_OBJECT:
+                write_container(value, depth, json_traits::get_object_begin(), json_traits::get_object_end());
+                break;
+            case JUSJON_JSON_VALUE_KEY:
+                write_string(value.data());
+                sink_.put(json_traits::get_colon());
+                if (options_.indent != 0)
+                    sink_.put(static_cast<char_type>(' '));
+                write_value(value.value(), depth);
+                break;
+            case JUSJON_JSON_VALUE_STRING:
+                write_string(value.data());
+                break;
+            case JUSJON_JSON_VALUE_NUMBER: {
+                const auto& data = value.data();
+                if (!data.empty()) {
+                    write_text(data);
+                    break;
+                }
+                char buffer[32]; // parsed without text
+                const char* const end = format_json_number(value.number(), buffer);
+                for (const char* p = buffer; p != end; ++p)
+                    sink_.put(static_cast<char_type>(*p));
+                break;
+            }
+            case JUSJON_JSON_VALUE_NULL:
+            case JUSJON_JSON_VALUE_TRUE:
+            case JUSJON_JSON_VALUE_FALSE:
+                write_text(value.data());
+                break;
+            default:
+                break;
+            }
+        }
+
+        template<class T>
+        struct field_writer { // visits the members of a JUJSON_BIND type
+            json_writer& writer;
+            const T& object;
+            JUJSON_SIZE_TYPE depth;
+            bool first;
+
+            template<class MemberPointerT_, MemberPointerT_ MemberT_>
+            void field(const char* name) {
+                if (!first)
+                    writer.sink_.put(json_traits::get_comma());
+                first = false;
+                writer.write_indent(depth + 1);
+                writer.sink_.put(json_traits::get_string_litteral_begin());
+                writer.write_literal(name);
+                writer.sink_.put(json_traits::get_string_litteral_end());
+                writer.sink_.put(json_traits::get_colon());
+                if (writer.options_.indent != 0)
+                    writer.sink_.put(static_cast<char_type>(' '));
+                writer.write_bound_value(object.*MemberT_, depth + 1);
+            }
+        };
+        void write_literal(const char* text) {
+            for (; *text != '\0'; ++text)
+                sink_.put(static_cast<char_type>(*text));
+        }
+        void write_number(const json_number& number) {
+            char buffer[32];
+            const char* const end = format_json_number(number, buffer);
+            for (const char* p = buffer; p != end; ++p)
+                sink_.put(static_cast<char_type>(*p));
+        }
+        template<class T>
+        void write_bound_value(const T& value, JUJSON_SIZE_TYPE depth) {
+            write_bound_value(value, depth, binding::category_of<T>());
+        }
+        template<class T>
+        void write_bound_value(const T& value, JUJSON_SIZE_TYPE, ::std::integral_constant<binding::category, binding::category_bool>) {
+            write_literal(value ? "true" : "false");
+        }
+        template<class T>
+        void write_bound_value(const T& value, JUJSON_SIZE_TYPE, ::std::integral_constant<binding::category, binding::category_integer>) {
+            json_number number;
+            if (::std::is_signed<T>::value) {
+                number.kind = JUJSON_NUMBER_KIND_INT64;
+                number.i = static_cast<::std::int64_t>(value);
+            } else {
+                number.u = static_cast<::std::uint64_t>(value);
+                number.kind = (number.u > static_cast<::std::uint64_t>(INT64_MAX)) ? JUJSON_NUMBER_KIND_UINT64 : JUJSON_NUMBER_KIND_INT64;
+            }
+            write_number(number);
+        }
+        template<class T>
+        void write_bound_value(const T& value, JUJSON_SIZE_TYPE, ::std::integral_constant<binding::category, binding::category_floating>) {
+            json_number number;
+            number.kind = JUJSON_NUMBER_KIND_DOUBLE;
+            number.d = static_cast<double>(value);
+            write_number(number);
+        }
+        template<class T>
+        void write_bound_value(const T& value, JUJSON_SIZE_TYPE, ::std::integral_constant<binding::category, binding::category_string>) {
+            sink_.put(json_traits::get_string_litteral_begin());
+            escape(value.begin(), value.end());
+            sink_.put(json_traits::get_string_litteral_end());
+        }
+        template<class T>
+        void write_bound_value(const T& value, JUJSON_SIZE_TYPE depth, ::std::integral_constant<binding::category, binding::category_array>) {
+            sink_.put(json_traits::get_array_begin());
+            bool first = true;
+            for (const auto& element : value) {
+                if (!first)
+                    sink_.put(json_traits::get_comma());
+                first = false;
+                write_indent(depth + 1);
+                write_bound_value(static_cast<const typename T::value_type&>(element), depth + 1);
+            }
+            if (!first)
+                write_indent(depth);
+            sink_.put(json_traits::get_array_end());
+        }
+        template<class T>
+        void write_bound_value(const T& value, JUJSON_SIZE_TYPE depth, ::std::integral_constant<binding::category, binding::category_object>) {
+            sink_.put(json_traits::get_object_begin());
+            field_writer<T> visitor = {*this, value, depth, true};
+            jujson_bind_fields(static_cast<const T*>(nullptr), visitor);
+            if (!visitor.first)
+                write_indent(depth);
+            sink_.put(json_traits::get_object_end());
+        }
+
+        public:
+        /**
+         * @brief Writes raw text as string litteral content: delimiters, escape characters and control characters escaped.
+         * @param b the beginning iterator. @param e the ending iterator.
+         */
+        template<class IteratorT_>
+        void escape(IteratorT_ b, IteratorT_ e) {
+            static const char hex[] = "0123456789abcdef";
+            for (; b != e; ++b) {
+                const auto val = *b;
+                const char_type c = static_cast<char_type>(val);
+                if (json_traits::is_string_litteral_begin(c) || json_traits::is_string_litteral_end(c) || json_traits::is_escape_spec(c)) {
+                    sink_.put(static_cast<char_type>('\\'));
+                    sink_.put(c);
+                } else if ((val >= 0) && (val < 0x20)) {
+                    sink_.put(static_cast<char_type>('\\'));
+                    switch (val) {
+                    case '\b': sink_.put(static_cast<char_type>('b')); break;
+                    case '\f': sink_.put(static_cast<char_type>('f')); break;
+                    case '\n': sink_.put(static_cast<char_type>('n')); break;
+                    case '\r': sink_.put(static_cast<char_type>('r')); break;
+                    case '\t': sink_.put(static_cast<char_type>('t')); break;
+                    default:
+                        sink_.put(static_cast<char_type>('u'));
+                        sink_.put(static_cast<char_type>('0'));
+                        sink_.put(static_cast<char_type>('0'));
+                        sink_.put(static_cast<char_type>(hex[val >> 4]));
+                        sink_.put(static_cast<char_type>(hex[val & 0xF]));
+                        break;
+                    }
+                } else {
+                    sink_.put(c);
+                }
+            }
+        }
+        /// @brief Writes the value and flushes the sink. @param value the json_value, or json_tape cursor, to write.
+        template<class JSONValueT_>
+        void write(const JSONValueT_& value) {
+            write_value(value, 0);
+            sink_.flush();
+        }
+        /**
+         * @brief Writes a bound object and flushes the sink, the inverse of json_parser::parse_into. Strings are escaped.
+         * @param object a bool, number, string, std::vector or JUJSON_BIND struct.
+         */
+        template<class T>
+        void write_bound(const T& object) {
+            write_bound_value(object, 0);
+            sink_.flush();
+        }
+        /**
+         * @brief Computes the exact size of the output of write, to reserve strings or buffers.
+         * @param value the json_value, or json_tape cursor. @param options the output options.
+         * @return The number of characters write would output.
+         */
+        template<class JSONValueT_>
+        [[nodiscard]] static JUJSON_SIZE_TYPE size(const JSONValueT_& value, const json_writer_options& options = json_writer_options()) {
+            json_size_sink<char_type> counter;
+            json_writer<json_size_sink<char_type>, JSONTraitsT_>(counter, options).write(value);
+            return counter.size();
+        }
+    };
+    /**
+     * @brief Escapes raw text to string litteral content, the inverse of unescape_json_string.
+     * @tparam OutStringT_ the type of the result string.
+     * @tparam JSONTraitsT_ the traits class used to define JSON-specific characteristics.
+     * @param b the beginning iterator. @param e the ending iterator.
+     * @return the escaped string, without delimiters.
+     */
+    template<class OutStringT_, class JSONTraitsT_ = default_json_traits<typename OutStringT_::value_type>, class IteratorT_>
+    [[nodiscard]] OutStringT_ escape_json_string(IteratorT_ b, IteratorT_ e) {
+        OutStringT_ result;
+        json_string_sink<OutStringT_> sink(result);
+        json_writer<json_string_sink<OutStringT_>, JSONTraitsT_>(sink).escape(b, e);
+        return result;
+    }
+    /**
+     * @brief Writes a bound object to a string, see json_writer::write_bound.
+     * @tparam OutStringT_ the type of the result string.
+     * @tparam JSONTraitsT_ the traits class used to define JSON-specific characteristics of the output.
+     * @param object a bool, number, string, std::vector or JUJSON_BIND struct. @param options the output options.
+     * @return the JSON text.
+     */
+    template<class OutStringT_, class JSONTraitsT_ = default_json_traits<typename OutStringT_::value_type>, class T>
+    [[nodiscard]] OutStringT_ bound_to_string(const T& object, const json_writer_options& options = json_writer_options()) {
+        OutStringT_ result;
+        json_string_sink<OutStringT_> sink(result);
+        json_writer<json_string_sink<OutStringT_>, JSONTraitsT_>(sink, options).write_bound(object);
+        return result;
+    }
+    /**
+     * @brief Base for handlers of json_parser::parse: reports nothing and never stops parsing.
+     *        Derive from it and hide only the member functions you need. Strings are given as ranges of the input,
+     *        string litterals and keys without delimiters and with escape sequences as they are in the input.
+     *        Returning false from any member function stops parsing with JUJSON_ERROR_CODE_ABORTED.
+     * @tparam IteratorT_ the iterator type of the parsed input.
+     */
+    template<class IteratorT_>
+    struct json_handler {
+        public:
+        bool on_null(IteratorT_, IteratorT_)            {return true;}
+        bool on_true(IteratorT_, IteratorT_)            {return true;}
+        bool on_false(IteratorT_, IteratorT_)           {return true;}
+        bool on_number(IteratorT_, IteratorT_)          {return true;}
+        bool on_string(IteratorT_, IteratorT_)          {return true;}
+        bool on_key(IteratorT_, IteratorT_)             {return true;}
+        bool on_array_begin(IteratorT_)                 {return true;} // points to the array begin
+        bool on_array_end(IteratorT_)                   {return true;} // points past the array end
+        bool on_object_begin(IteratorT_)                {return true;} // points to the object begin
+        bool on_object_end(IteratorT_)                  {return true;} // points past the object end
+    };
+    /**
+     * @brief Stores strings for parsed values: intern() keeps one copy of equal strings, store() copies a string once more.
+     *        Given to json_parser::set_string_pool, or owned by json_document, it holds the keys of the parsed values, so that
+     *        with std::string_view the repeated keys of arrays of objects are stored once and the values no longer refer to the input.
+     *        Stored strings never move and live until clear() or the destruction of the pool.
+     * @tparam CharT_ the character type of the strings.
+     * @tparam AllocatorT_ the allocator of the pool, rebound as needed.
+     */
+    template<class CharT_, class AllocatorT_ = ::std::allocator<char>>
+    struct json_string_pool final {
+        public:
+        typedef CharT_ char_type;
+        typedef AllocatorT_ allocator_type;
+
+        private:
+        struct block {
+            char_type* data;
+            JUJSON_SIZE_TYPE size;
+        };
+        struct entry { // slot of the open addressing table, data is nullptr for free slots
+            const char_type* data;
+            JUJSON_SIZE_TYPE size;
+            JUJSON_SIZE_TYPE hash;
+        };
+        typedef typename ::std::allocator_traits<AllocatorT_>::template rebind_alloc<char_type> char_allocator;
+        typedef ::std::allocator_traits<char_allocator> char_allocator_traits;
+        typedef JUJSON_DEFAULT_CONTAINER<block, typename ::std::allocator_traits<AllocatorT_>::template rebind_alloc<block>> block_container;
+        typedef JUJSON_DEFAULT_CONTAINER<entry, typename ::std::allocator_traits<AllocatorT_>::template rebind_alloc<entry>> entry_container;
+        static const JUJSON_SIZE_TYPE block_size = 16 * 1024; // in characters, larger strings get a block of their own
+
+        private:
+        char_allocator allocator_;
+        block_container blocks_;
+        entry_container slots_;
+        char_type* current_; // free space of the last block
+        JUJSON_SIZE_TYPE available_;
+        JUJSON_SIZE_TYPE count_; // interned strings
+
+        public:
+        /// @brief Constructs an empty json_string_pool. @param alloc the allocator of the pool.
+        explicit json_string_pool(const allocator_type& alloc = allocator_type()) : allocator_(alloc), blocks_(alloc), slots_(alloc), current_(nullptr), available_(0), count_(0) {
+
+        }
+        json_string_pool(const json_string_pool&) = delete;
+        json_string_pool& operator=(const json_string_pool&) = delete;
+        /// @brief Moves the pool, stored strings keep their address. @param other the pool to move, left empty.
+        json_string_pool(json_string_pool&& other) noexcept : allocator_(other.allocator_), blocks_(JUJSON_MOVE(other.blocks_)), slots_(JUJSON_MOVE(other.slots_)),
+            current_(other.current_), available_(other.available_), count_(other.count_) {
+            other.forget();
+        }
+        /// @brief Moves the pool, stored strings keep their address. @param other the pool to move, left empty.
+        json_string_pool& operator=(json_string_pool&& other) noexcept {
+            if (this != &other) {
+                clear();
+                allocator_ = other.allocator_;
+                blocks_.swap(other.blocks_);
+                slots_.swap(other.slots_);
+                current_ = other.current_;
+                available_ = other.available_;
+                count_ = other.count_;
+                other.forget();
+            }
+            return *this;
+        }
+        ~json_string_pool() {
+            clear();
+        }
+
+        private:
+        template<class IteratorT_>
+        static JUJSON_SIZE_TYPE hash(IteratorT_ b, IteratorT_ e) noexcept { // FNV-1a over characters
+            ::std::uint64_t result = 14695981039346656037ull;
+            for (; b != e; ++b) {
+                result ^= static_cast<::std::uint64_t>(static_cast<typename ::std::make_unsigned<char_type>::type>(*b));
+                result *= 1099511628211ull;
+            }
+            return static_cast<JUJSON_SIZE_TYPE>(result ^ (result >> 32));
+        }
+        char_type* allocate(JUJSON_SIZE_TYPE size) {
+            if (size > available_) {
+                const bool own = size > block_size / 4; // keeps the free space of the current block
+                const JUJSON_SIZE_TYPE blockSize = own ? size : block_size;
+                blocks_.reserve(blocks_.size() + 1);
+                const block allocated = {char_allocator_traits::allocate(allocator_, blockSize), blockSize};
+                blocks_.push_back(allocated);
+                if (own)
+                    return allocated.data;
+                current_ = allocated.data;
+                available_ = blockSize;
+            }
+            char_type* result = current_;
+            current_ += size;
+            available_ -= size;
+            return result;
+        }
+        void forget() noexcept { // after the blocks moved to another pool
+            blocks_.clear();
+            slots_.clear();
+            current_ = nullptr;
+            available_ = 0;
+            count_ = 0;
+        }
+        void grow() {
+            entry_container slots(slots_.empty() ? 256 : slots_.size() * 2, entry(), slots_.get_allocator());
+            const JUJSON_SIZE_TYPE mask = static_cast<JUJSON_SIZE_TYPE>(slots.size()) - 1;
+            for (const entry& interned : slots_) {
+                if (interned.data == nullptr)
+                    continue;
+                JUJSON_SIZE_TYPE slot = interned.hash & mask;
+                while (slots[slot].data != nullptr)
+                    slot = (slot + 1) & mask;
+                slots[slot] = interned;
+            }
+            slots_.swap(slots);
+        }
+
+        public:
+        /**
+         * @brief Gets the stored copy of the string [b, e), stored first if no equal string was interned before.
+         * @param b the beginning iterator. @param e the ending iterator.
+         * @return A pointer to the characters of the stored copy, e - b characters long.
+         */
+        template<class IteratorT_>
+        const char_type* intern(IteratorT_ b, IteratorT_ e) {
+            const JUJSON_SIZE_TYPE size = static_cast<JUJSON_SIZE_TYPE>(e - b);
+            if (size == 0)
+                return current_;
+            const JUJSON_SIZE_TYPE h = hash(b, e);
+            if ((count_ + 1) * 2 > static_cast<JUJSON_SIZE_TYPE>(slots_.size()))
+                grow();
+            const JUJSON_SIZE_TYPE mask = static_cast<JUJSON_SIZE_TYPE>(slots_.size()) - 1;
+            JUJSON_SIZE_TYPE slot = h & mask;
+            for (; slots_[slot].data != nullptr; slot = (slot + 1) & mask) {
+                const entry& interned = slots_[slot];
+                if ((interned.hash == h) && (interned.size == size) && ::std::equal(b, e, interned.data))
+                    return interned.data;
+            }
+            const char_type* result = store(b, e);
+            const entry interned = {result, size, h};
+            slots_[slot] = interned;
+            ++count_;
+            return result;
+        }
+        /**
+         * @brief Stores a copy of the string [b, e), without looking for an equal string.
+         * @param b the beginning iterator. @param e the ending iterator.
+         * @return A pointer to the characters of the copy, e - b characters long.
+         */
+        template<class IteratorT_>
+        const char_type* store(IteratorT_ b, IteratorT_ e) {
+            char_type* result = allocate(static_cast<JUJSON_SIZE_TYPE>(e - b));
+            ::std::copy(b, e, result);
+            return result;
+        }
+        /// @brief Releases all stored strings, values referring to them must be destroyed first.
+        void clear() noexcept {
+            for (const block& allocated : blocks_)
+                char_allocator_traits::deallocate(allocator_, allocated.data, allocated.size);
+            block_container(blocks_.get_allocator()).swap(blocks_); // no storage is kept, the allocator may be an arena released next
+            entry_container(slots_.get_allocator()).swap(slots_);
+            current_ = nullptr;
+            available_ = 0;
+            count_ = 0;
+        }
+        /// @brief Gets the number of distinct interned strings. @return The number of interned strings.
+        [[nodiscard]] JUJSON_SIZE_TYPE size() const noexcept {
+            return count_;
+        }
+    };
+    /// @brief Options of json_parser for building json_value trees.
+    struct json_parser_options {
+        bool keyIndex; // build key indexes of objects while parsing, so that find never modifies the parsed tree.
+        bool numberText; // keep the text of numbers in data(), otherwise numbers are decoded only.
+        bool lazy; // arrays and objects below the top level are validated but built on first access, from their text kept in one string.
+        JUJSON_SIZE_TYPE internLength; // with a json_string_pool, strings and number texts up to this length are interned like keys, longer ones are copied into the pool.
+        JUJSON_SIZE_TYPE maxDepth; // deeper nesting of arrays and objects fails with JUJSON_ERROR_CODE_DEPTH, 0 for no limit. Destroying, copying and writing json_value recurse per level.
+        bool validateEncoding; // string litterals must be valid UTF-8, UTF-16 or UTF-32 by the size of the code units, see find_invalid_encoding, or parsing fails with JUJSON_ERROR_CODE_INVALID_ENCODING.
+
+        json_parser_options() : keyIndex(false), numberText(true), lazy(false), internLength(0), maxDepth(1024), validateEncoding(false) {
+
+        }
+    };
+    /// @brief Position policy of json_parser: line and column are counted while scanning, so line() and column() are cheap at any time.
+    struct json_eager_position : ::std::true_type {};
+    /// @brief Position policy of json_parser: nothing is counted while scanning, line() and column() rescan the input when called, usually after an error.
+    struct json_lazy_position : ::std::false_type {};
+    template<class StringT_, class JSONTraitsT_, class AllocatorT_, class PositionT_> struct json_parser;
+    template<class JSONValueT_> struct json_value_builder;
+    template<class StringT_, class JSONTraitsT_> struct json_binary_view;
+    template<class StringT_, class JSONTraitsT_> struct json_compact_tree;
+    namespace patch {
+        struct access;
+    }
+    /**
+     * @brief Represents a JSON value, which can be a null, boolean, string, number, array, or object.
+     * @tparam StringT_ the type of the string to use.
+     * @tparam JSONTraitsT_ the traits class used to define JSON-specific characteristics.
+     * @tparam AllocatorT_ the allocator used for child elements, and for strings if StringT_ is allocator-aware. Rebound as needed.
+     */
+    template <class StringT_, class JSONTraitsT_ = default_json_traits<typename StringT_::value_type>, class AllocatorT_ = ::std::allocator<char>>
+    struct json_value final {
+        public:
+        typedef StringT_ string_type;
+        typedef JSONTraitsT_ traits_type;
+        typedef AllocatorT_ allocator_type;
+        typedef JUJSON_DEFAULT_CONTAINER<json_value, typename ::std::allocator_traits<AllocatorT_>::template rebind_alloc<json_value>> container_type;
+
+        private:
+        typedef JSONTraitsT_ json_traits;
+        typedef typename StringT_::value_type char_type;
+        typedef typename ::std::allocator_traits<AllocatorT_>::template rebind_alloc<JUJSON_SIZE_TYPE> index_slot_allocator;
+        struct key_index { // open addressing table of child positions by key hash
+            JUJSON_DEFAULT_CONTAINER<JUJSON_SIZE_TYPE, index_slot_allocator> slots; // position + 1, 0 for an empty slot
+            const json_value* childs; // childs_.data() and childs_.size() when the slots were filled, the index is built again when they change
+            JUJSON_SIZE_TYPE size;
+            bool shared; // keys may have been changed through references handed out by non-const get_childs or find, keys missing in the slots are searched linearly
+
+            key_index(JUJSON_SIZE_TYPE slotCount, const index_slot_allocator& alloc) : slots(slotCount, 0, alloc), childs(nullptr), size(0), shared(false) {
+
+            }
+        };
+        typedef typename ::std::allocator_traits<AllocatorT_>::template rebind_alloc<key_index> index_allocator;
+        typedef ::std::allocator_traits<index_allocator> index_allocator_traits;
+        enum lazy_flags : unsigned char { // options of the parse on first access, see json_parser_options::lazy
+            lazy_pending = 1,
+            lazy_key_index = 2,
+            lazy_number_text = 4,
+            lazy_cached_text = 8, // data_ holds the text of the parsed childs written by to_string_cached, data() hides it
+            lazy_shared_childs = 16, // non-const get_childs or find handed out references that may change the childs later, their text is not kept
+        };
+
+        template<class> friend struct json_value_builder; // constructs lazy containers
+        template<class, class> friend struct json_binary_view; // constructs numbers with their decoded value
+        template<class, class> friend struct json_compact_tree; // constructs numbers with their decoded value
+        template<class, class, class, class> friend struct json_parser; // fills arrays without handing their childs out
+        friend struct patch::access; // changes childs without handing references out
+
+        private:
+        json_value_kind kind_;
+        mutable unsigned char lazy_; // lazy_flags of an array or object whose text is in data_, or lazy_shared_childs
+        json_number number_; // decoded JUSJON_JSON_VALUE_NUMBER
+        mutable StringT_ data_; // data of json value. 
+        mutable container_type childs_;
+        mutable key_index* index_; // built on demand for objects, from the allocator of childs_
+
+        public:
+        ///@brief Constructs a default json_value object with invalid kind.
+        json_value() : kind_(JUSJON_JSON_VALUE_INVALID), lazy_(0), number_(), data_(), childs_(), index_(nullptr) {
+            
+        }
+        /// @brief Constructs a json_value object with the specified kind. @param kind the kind of the json_value.
+        json_value(json_value_kind kind) : kind_(kind), lazy_(0), number_(), data_(), childs_(), index_(nullptr) {
+
+        }
+        /**
+         * @brief Constructs a json_value object with the specified data and kind.
+         * @param data the data of the json_value.
+         * @param kind the kind of the json_value.
+         */
+        json_value(const StringT_& data, json_value_kind kind) : kind_(kind), lazy_(0), number_(decode_number(data, kind)), data_(data), childs_(), index_(nullptr) {
+
+        }
+        /** 
+         * @brief Constructs a json_value object with the specified data and kind, moving the data.
+         * @param data the data of the json_value.
+         * @param kind the kind of the json_value.
+         */
+        json_value(StringT_&& data, json_value_kind kind) : kind_(kind), lazy_(0), number_(decode_number(data, kind)), data_(JUJSON_MOVE(data)), childs_(), index_(nullptr) {
+
+        }
+        /// @brief Constructs a json_value object with the specified kind and allocator. @param kind the kind of the json_value. @param alloc the allocator to use.
+        json_value(json_value_kind kind, const allocator_type& alloc) : kind_(kind), lazy_(0), number_(), data_(string_traits<StringT_>::copy(StringT_(), alloc)), childs_(alloc), index_(nullptr) {
+
+        }
+        /**
+         * @brief Constructs a json_value object with the specified data, kind and allocator. The data is expected to be allocated with alloc.
+         * @param data the data of the json_value.
+         * @param kind the kind of the json_value.
+         * @param alloc the allocator to use.
+         */
+        json_value(StringT_&& data, json_value_kind kind, const allocator_type& alloc) : kind_(kind), lazy_(0), number_(decode_number(data, kind)), data_(JUJSON_MOVE(data)), childs_(alloc), index_(nullptr) {
+
+        }
+        /**
+         * @brief Constructs a JUSJON_JSON_VALUE_NUMBER json_value from a decoded number, without text: data() is empty.
+         * @param number the number. @param alloc the allocator to use.
+         */
+        explicit json_value(const json_number& number, const allocator_type& alloc = allocator_type()) : kind_(JUSJON_JSON_VALUE_NUMBER), lazy_(0), number_(number),
+            data_(string_traits<StringT_>::copy(StringT_(), alloc)), childs_(alloc), index_(nullptr) {
+
+        }
+        /// @brief Copies the json_value, the key index is not copied. @param other the json_value to copy.
+        json_value(const json_value& other) : kind_(other.kind_), lazy_(other.lazy_), number_(other.number_), data_(other.data_), childs_(other.childs_), index_(nullptr) {
+
+        }
+        /// @brief Moves the json_value with its key index. @param other the json_value to move.
+        json_value(json_value&& other) noexcept : kind_(other.kind_), lazy_(other.lazy_), number_(other.number_), data_(JUJSON_MOVE(other.data_)), childs_(JUJSON_MOVE(other.childs_)), index_(other.index_) {
+            other.index_ = nullptr;
+        }
+        ~json_value() {
+            drop_key_index();
+        }
+        /// @brief Copies the json_value using the specified allocator. @param other the json_value to copy. @param alloc the allocator to use.
+        json_value(const json_value& other, const allocator_type& alloc) : kind_(other.kind_), lazy_(other.lazy_), number_(other.number_), data_(string_traits<StringT_>::copy(other.data_, alloc)), childs_(other.childs_, alloc), index_(nullptr) {
+
+        }
+        /// @brief Moves the json_value using the specified allocator, copies elements if allocators differ. @param other the json_value to move. @param alloc the allocator to use.
+        json_value(json_value&& other, const allocator_type& alloc) : kind_(other.kind_), lazy_(other.lazy_), number_(other.number_), data_(string_traits<StringT_>::move(JUJSON_MOVE(other.data_), alloc)), childs_(JUJSON_MOVE(other.childs_), alloc), index_(nullptr) {
+            if (childs_.get_allocator() == other.childs_.get_allocator()) {
+                index_ = other.index_;
+                other.index_ = nullptr;
+            } else {
+                other.drop_key_index();
+            }
+        }
+        json_value& operator=(const json_value& other) {
+            if (this != &other) {
+                drop_key_index();
+                kind_ = other.kind_;
+                lazy_ = other.lazy_;
+                number_ = other.number_;
+                data_ = other.data_;
+                childs_ = other.childs_;
+            }
+            return *this;
+        }
+        json_value& operator=(json_value&& other) noexcept(::std::is_nothrow_move_assignable<StringT_>::value && ::std::is_nothrow_move_assignable<container_type>::value) {
+            if (this != &other) {
+                drop_key_index();
+                const bool sameAllocator = (childs_.get_allocator() == other.childs_.get_allocator());
+                kind_ = other.kind_;
+                lazy_ = other.lazy_;
+                number_ = other.number_;
+                data_ = JUJSON_MOVE(other.data_);
+                childs_ = JUJSON_MOVE(other.childs_);
+                if (sameAllocator && (childs_.get_allocator() == other.childs_.get_allocator())) { // the index is freed with the allocator of childs_
+                    index_ = other.index_;
+                    other.index_ = nullptr;
+                } else {
+                    other.drop_key_index();
+                }
+            }
+            return *this;
+        }
+
+        private:
+        /// @brief Constructs a JUSJON_JSON_VALUE_NUMBER from its text and its number decoded already.
+        json_value(StringT_&& text, const json_number& number, const allocator_type& alloc) : kind_(JUSJON_JSON_VALUE_NUMBER), lazy_(0), number_(number),
+            data_(JUJSON_MOVE(text)), childs_(alloc), index_(nullptr) {
+
+        }
+        /// @brief Constructs a lazy JUSJON_JSON_VALUE_ARRAY or JUSJON_JSON_VALUE_OBJECT from its validated text, parsed on first access.
+        json_value(StringT_&& text, json_value_kind kind, const allocator_type& alloc, unsigned char lazy) : kind_(kind), lazy_(lazy), number_(),
+            data_(JUJSON_MOVE(text)), childs_(alloc), index_(nullptr) {
+
+        }
+        // parses the childs of a lazy container, containers below them stay lazy.
+        void expand() const {
+            if ((lazy_ & lazy_pending) == 0)
+                return;
+            json_parser_options options;
+            options.keyIndex = ((lazy_ & lazy_key_index) != 0);
+            options.numberText = ((lazy_ & lazy_number_text) != 0);
+            options.lazy = true;
+            options.maxDepth = 0; // checked when skipped
+            const AllocatorT_ alloc(childs_.get_allocator());
+            json_parser<StringT_, json_traits, AllocatorT_, json_lazy_position> parser(data_, alloc);
+            json_value_builder<json_value> builder(alloc, options);
+            const bool parsed = parser.parse(builder);
+            JUJSON_ASSERT(parsed); // validated when skipped
+            (void)parsed;
+            json_value result = builder.release();
+            drop_key_index();
+            const bool sameAllocator = (childs_.get_allocator() == result.childs_.get_allocator());
+            childs_ = JUJSON_MOVE(result.childs_);
+            if (sameAllocator) {
+                index_ = result.index_;
+                result.index_ = nullptr;
+            }
+            data_ = string_traits<StringT_>::copy(StringT_(), alloc);
+            lazy_ = 0;
+        }
+        // the childs may change: the text kept by to_string_cached is dropped, its storage is kept for the next one.
+        void drop_cached_text() const {
+            if ((lazy_ & lazy_cached_text) == 0)
+                return;
+            clear_text(data_, ::std::is_same<StringT_, typename string_traits<StringT_>::owning_string_type>());
+            lazy_ &= static_cast<unsigned char>(~lazy_cached_text);
+        }
+        // gets the childs for a change made before the caller returns, references to them are not kept and keys are not changed.
+        container_type& changed_childs() {
+            expand();
+            drop_cached_text();
+            return childs_;
+        }
+        // references to the childs are handed out, to_string_cached does not keep the text of this value until clear_cached_text.
+        void share_childs() {
+            drop_cached_text();
+            lazy_ |= lazy_shared_childs;
+        }
+        static void clear_text(StringT_& text, ::std::true_type) {
+            text.clear();
+        }
+        static void clear_text(StringT_& text, ::std::false_type) { // views never keep text
+            text = StringT_();
+        }
+        // writes the compact text of the value as json_writer does, keeping it in arrays and objects of at least minimumSize characters.
+        // returns false if childs below may be changed through references handed out before, then the text of the path is not kept.
+        bool write_cached(StringT_& result, JUJSON_SIZE_TYPE minimumSize) const {
+            typedef default_json_traits<char_type> output_traits; // as to_string
+            bool keep = ((lazy_ & lazy_shared_childs) == 0);
+            switch (kind_) {
+            case JUSJON_JSON_VALUE_ARRAY:
+            case JUSJON_JSON_VALUE_OBJECT: {
+                if ((lazy_ & lazy_cached_text) != 0) {
+                    result.append(data_);
+                    return true;
+                }
+                expand();
+                const typename StringT_::size_type begin = result.size();
+                result += (kind_ == JUSJON_JSON_VALUE_ARRAY) ? output_traits::get_array_begin() : output_traits::get_object_begin();
+                for (typename container_type::size_type i = 0; i < childs_.size(); ++i) {
+                    if (i != 0)
+                        result += output_traits::get_comma();
+                    keep = childs_[i].write_cached(result, minimumSize) && keep;
+                }
+                result += (kind_ == JUSJON_JSON_VALUE_ARRAY) ? output_traits::get_array_end() : output_traits::get_object_end();
+                if (keep && (static_cast<JUJSON_SIZE_TYPE>(result.size() - begin) >= minimumSize)) {
+                    data_.assign(result, begin, StringT_::npos);
+                    lazy_ = lazy_cached_text;
+                }
+                break;
+            }
+            case JUSJON_JSON_VALUE_KEY:
+                result += output_traits::get_string_litteral_begin();
+                result.append(data_);
+                result += output_traits::get_string_litteral_end();
+                result += output_traits::get_colon();
+                keep = childs_[0].write_cached(result, minimumSize) && keep;
+                break;
+            case JUSJON_JSON_VALUE_STRING:
+                result += output_traits::get_string_litteral_begin();
+                result.append(data_);
+                result += output_traits::get_string_litteral_end();
+                break;
+            case JUSJON_JSON_VALUE_NUMBER:
+                if (data_.empty()) // parsed without text
+                    append_json_number(result, number_);
+                else
+                    result.append(data_);
+                break;
+            case JUSJON_JSON_VALUE_NULL:
+            case JUSJON_JSON_VALUE_TRUE:
+            case JUSJON_JSON_VALUE_FALSE:
+                result.append(data_);
+                break;
+            default:
+                break;
+            }
+            return keep;
+        }
+        static json_number decode_number(const StringT_& data, json_value_kind kind) {
+            return (kind == JUSJON_JSON_VALUE_NUMBER) ? decode_json_number<json_traits>(data.begin(), data.end()) : json_number();
+        }
+        template<class IteratorT_>
+        static JUJSON_SIZE_TYPE key_hash(IteratorT_ b, IteratorT_ e) noexcept { // FNV-1a over characters
+            ::std::uint64_t result = 14695981039346656037ull;
+            for (; b != e; ++b) {
+                result ^= static_cast<::std::uint64_t>(static_cast<typename ::std::make_unsigned<char_type>::type>(*b));
+                result *= 1099511628211ull;
+            }
+            return static_cast<JUJSON_SIZE_TYPE>(result ^ (result >> 32));
+        }
+        bool key_equals(const char_type* toFind, JUJSON_SIZE_TYPE size) const noexcept {
+            return (static_cast<JUJSON_SIZE_TYPE>(data_.size()) == size) && ((data_.data() == toFind) || ::std::equal(data_.begin(), data_.end(), toFind)); // interned keys are the same
+        }
+        void drop_key_index() const noexcept {
+            if (index_ == nullptr)
+                return;
+            index_allocator alloc(childs_.get_allocator());
+            index_allocator_traits::destroy(alloc, index_);
+            index_allocator_traits::deallocate(alloc, index_, 1);
+            index_ = nullptr;
+        }
+        // references to the keys are handed out, they may be renamed through them.
+        void share_keys() noexcept {
+            if (index_ != nullptr)
+                index_->shared = true;
+        }
+        // builds the index if there is no index for the current childs, returns false if the object is too small to index.
+        bool ensure_key_index(JUJSON_SIZE_TYPE threshold) const {
+            if ((index_ != nullptr) && (index_->childs == childs_.data()) && (index_->size == static_cast<JUJSON_SIZE_TYPE>(childs_.size())))
+                return true;
+            const bool shared = (index_ != nullptr) && index_->shared; // the references handed out may still be used
+            drop_key_index();
+            if ((static_cast<JUJSON_SIZE_TYPE>(childs_.size()) < threshold) || childs_.empty())
+                return false;
+            JUJSON_SIZE_TYPE slotCount = 1;
+            while (slotCount < static_cast<JUJSON_SIZE_TYPE>(childs_.size()) * 2)
+                slotCount <<= 1;
+            index_allocator alloc(childs_.get_allocator());
+            key_index* const index = index_allocator_traits::allocate(alloc, 1);
+            try {
+                index_allocator_traits::construct(alloc, index, slotCount, index_slot_allocator(childs_.get_allocator()));
+            } catch (...) {
+                index_allocator_traits::deallocate(alloc, index, 1);
+                throw;
+            }
+            index->childs = childs_.data();
+            index->size = static_cast<JUJSON_SIZE_TYPE>(childs_.size());
+            index->shared = shared;
+            const JUJSON_SIZE_TYPE mask = slotCount - 1;
+            for (JUJSON_SIZE_TYPE position = 0; position < static_cast<JUJSON_SIZE_TYPE>(childs_.size()); ++position) {
+                const StringT_& key = childs_[position].data_;
+                for (JUJSON_SIZE_TYPE slot = key_hash(key.begin(), key.end()) & mask; ; slot = (slot + 1) & mask) {
+                    if (index->slots[slot] == 0) {
+                        index->slots[slot] = position + 1;
+                        break;
+                    }
+                    if (childs_[index->slots[slot] - 1].data_ == key) // duplicate keys, the first one is found as with linear search
+                        break;
+                }
+            }
+            index_ = index;
+            return true;
+        }
+        JUJSON_SIZE_TYPE find_position(const char_type* toFind, JUJSON_SIZE_TYPE size) const {
+            if (kind_ != JUSJON_JSON_VALUE_OBJECT)
+                return static_cast<JUJSON_SIZE_TYPE>(childs_.size());
+            expand();
+            if (ensure_key_index(JUJSON_KEY_INDEX_THRESHOLD)) {
+                const JUJSON_SIZE_TYPE mask = static_cast<JUJSON_SIZE_TYPE>(index_->slots.size()) - 1;
+                for (JUJSON_SIZE_TYPE slot = key_hash(toFind, toFind + size) & mask; index_->slots[slot] != 0; slot = (slot + 1) & mask) {
+                    const JUJSON_SIZE_TYPE position = index_->slots[slot] - 1;
+                    if (childs_[position].key_equals(toFind, size))
+                        return position;
+                }
+                if (!index_->shared)
+                    return static_cast<JUJSON_SIZE_TYPE>(childs_.size());
+                for (JUJSON_SIZE_TYPE position = 0; position < static_cast<JUJSON_SIZE_TYPE>(childs_.size()); ++position) {
+                    if (childs_[position].key_equals(toFind, size)) { // renamed through a reference, the slots are filled again
+                        index_->childs = nullptr;
+                        ensure_key_index(JUJSON_KEY_INDEX_THRESHOLD);
+                        return position;
+                    }
+                }
+                return static_cast<JUJSON_SIZE_TYPE>(childs_.size());
+            }
+            for (JUJSON_SIZE_TYPE position = 0; position < static_cast<JUJSON_SIZE_TYPE>(childs_.size()); ++position) {
+                if (childs_[position].key_equals(toFind, size))
+                    return position;
+            }
+            return static_cast<JUJSON_SIZE_TYPE>(childs_.size());
+        }
+
+        public:
+        /**
+         * @brief Gets the child elements of the json_value, parsing them first for lazy containers. As they may be changed later through the reference,
+         *        find() searches keys missing in the key index linearly, and to_string_cached drops the text of the value and keeps none until clear_cached_text().
+         * @return A reference to the container of child elements.
+         */
+        [[nodiscard]] container_type& get_childs() {
+            container_type& result = changed_childs();
+            share_keys();
+            share_childs();
+            return result;
+        }
+        /// @brief Gets the child elements of the json_value, parsing them first for lazy containers. @return A reference to the container of child elements.
+        [[nodiscard]] const container_type& get_childs() const {
+            expand();
+            return childs_;
+        }
+        /// @brief Gets the kind of the json_value. @return The kind of the json_value.
+        [[nodiscard]] json_value_kind kind() const noexcept {
+            return kind_;
+        }
+        /// @brief Checks if the json_value is valid. @return True if the json_value is valid, false otherwise.
+        [[nodiscard]] bool is_valid() const noexcept {
+            return kind_ != JUSJON_JSON_VALUE_INVALID;
+        }
+        /// @brief Checks if the childs are parsed. @return False for lazy containers not accessed yet, true otherwise.
+        [[nodiscard]] bool is_parsed() const noexcept {
+            return (lazy_ & lazy_pending) == 0;
+        }
+        /// @brief Gets the data of the json_value. @return A const reference to the data of the json_value, empty for containers.
+        [[nodiscard]] const StringT_& data() const {
+            expand();
+            if ((lazy_ & lazy_cached_text) != 0) { // data_ holds the text kept by to_string_cached
+                static const StringT_ empty = StringT_();
+                return empty;
+            }
+            return data_;
+        }     
+        /**
+         * @brief Gets the data of the json_value with escape sequences decoded. Useful for JUSJON_JSON_VALUE_STRING and JUSJON_JSON_VALUE_KEY,
+         *        data() keeps them as they are in the input.
+         * @return The decoded data of the json_value, empty for arrays and objects.
+         */
+        [[nodiscard]] typename string_traits<StringT_>::owning_string_type decoded_data() const {
+            if ((kind_ == JUSJON_JSON_VALUE_ARRAY) || (kind_ == JUSJON_JSON_VALUE_OBJECT)) // data_ may hold the text of a lazy container
+                return typename string_traits<StringT_>::owning_string_type();
+            return unescape_json_string<typename string_traits<StringT_>::owning_string_type, json_traits>(data_.begin(), data_.end());
+        }
+        /// @brief Gets the number decoded while parsing, for JUSJON_JSON_VALUE_NUMBER. @return The number, JUJSON_NUMBER_KIND_INVALID for other kinds.
+        [[nodiscard]] const json_number& number() const noexcept {
+            return number_;
+        }
+        /// @brief Checks if the json_value is an integer number. @return True for integer numbers, false otherwise.
+        [[nodiscard]] bool is_integer() const noexcept {
+            return number_.is_integer();
+        }
+        /// @brief Gets the number as int64, see json_number::as_int64. @return The number, 0 if it's not a number.
+        [[nodiscard]] ::std::int64_t as_int64() const noexcept {
+            return number_.as_int64();
+        }
+        /// @brief Gets the number as uint64, see json_number::as_uint64. @return The number, 0 if it's not a number.
+        [[nodiscard]] ::std::uint64_t as_uint64() const noexcept {
+            return number_.as_uint64();
+        }
+        /// @brief Gets the number as double. @return The number, 0 if it's not a number.
+        [[nodiscard]] double as_double() const noexcept {
+            return number_.as_double();
+        }
+        /// @brief Gets the first child element if kind is equal to JUSJON_JSON_VALUE_KEY. @return A const reference to the child element.
+        [[nodiscard]] const json_value& value() const {
+            if (kind_ != JUSJON_JSON_VALUE_KEY)
+                JUJSON_ASSERT(false);
+            return childs_[0];
+        }     
+        /// @brief Adds a child element to the json_value. @param obj the child element to add.
+        void add_child(const json_value& obj) {
+            expand();
+            drop_cached_text();
+            drop_key_index();
+            return childs_.push_back(obj);
+        }   
+        /// @brief Adds a child element to the json_value, moving the element. @param obj the child element to add.
+        void add_child(json_value&& obj) {
+            expand();
+            drop_cached_text();
+            drop_key_index();
+            return childs_.push_back(JUJSON_MOVE(obj));
+        }
+        /**
+         * @brief Finds a child element with the specified key. Objects with at least JUJSON_KEY_INDEX_THRESHOLD keys are searched
+         *        through a hashed index built on the first call, after that a const find does not modify the object.
+         *        The non-const overloads let the keys be renamed through the iterator and stop to_string_cached from keeping the text of the object, as non-const get_childs() does.
+         * @param toFind the key to find.
+         * @return An iterator to the found element, or end() if not found. RETURNS KV(KEY/VALUE) NOT A VALUE ITSELF.
+         */
+        [[nodiscard]] typename container_type::iterator find(const StringT_& toFind) {
+            const JUJSON_SIZE_TYPE position = find_position(toFind.data(), static_cast<JUJSON_SIZE_TYPE>(toFind.size())); // parses a lazy object first, replacing childs_
+            share_keys();
+            share_childs();
+            return childs_.begin() + position;
+        }
+        /**
+         * @brief Finds a child element with the specified key.
+         * @param toFind the key to find.
+         * @return An iterator to the found element, or end() if not found.
+         */
+        [[nodiscard]] typename container_type::const_iterator find(const StringT_& toFind) const {
+            const JUJSON_SIZE_TYPE position = find_position(toFind.data(), static_cast<JUJSON_SIZE_TYPE>(toFind.size()));
+            return childs_.begin() + position;
+        }
+        /// @brief Finds a child element with the specified null-terminated key, without a string temporary. @param toFind the key to find. @return An iterator to the found element, or end() if not found.
+        [[nodiscard]] typename container_type::iterator find(const char_type* toFind) {
+            const JUJSON_SIZE_TYPE position = find_position(toFind, static_cast<JUJSON_SIZE_TYPE>(::std::char_traits<char_type>::length(toFind)));
+            share_keys();
+            share_childs();
+            return childs_.begin() + position;
+        }
+        /// @brief Finds a child element with the specified null-terminated key, without a string temporary. @param toFind the key to find. @return An iterator to the found element, or end() if not found.
+        [[nodiscard]] typename container_type::const_iterator find(const char_type* toFind) const {
+            const JUJSON_SIZE_TYPE position = find_position(toFind, static_cast<JUJSON_SIZE_TYPE>(::std::char_traits<char_type>::length(toFind)));
+            return childs_.begin() + position;
+        }
+#if (JUJSON_HAS_STRING_VIEW)
+        /// @brief Finds a child element with the specified key. @param toFind the key to find. @return An iterator to the found element, or end() if not found.
+        template<class ViewT_, class = typename ::std::enable_if<::std::is_same<ViewT_, ::std::basic_string_view<char_type>>::value && !::std::is_same<ViewT_, StringT_>::value>::type>
+        [[nodiscard]] typename container_type::iterator find(const ViewT_& toFind) {
+            const JUJSON_SIZE_TYPE position = find_position(toFind.data(), static_cast<JUJSON_SIZE_TYPE>(toFind.size()));
+            share_keys();
+            share_childs();
+            return childs_.begin() + position;
+        }
+        /// @brief Finds a child element with the specified key. @param toFind the key to find. @return An iterator to the found element, or end() if not found.
+        template<class ViewT_, class = typename ::std::enable_if<::std::is_same<ViewT_, ::std::basic_string_view<char_type>>::value && !::std::is_same<ViewT_, StringT_>::value>::type>
+        [[nodiscard]] typename container_type::const_iterator find(const ViewT_& toFind) const {
+            const JUJSON_SIZE_TYPE position = find_position(toFind.data(), static_cast<JUJSON_SIZE_TYPE>(toFind.size()));
+            return childs_.begin() + position;
+        }
+#endif
+        /**
+         * @brief Builds the key index of this object, so later lookups never modify it, e.g. for concurrent reading.
+         *        Lazy containers are parsed first, recursively too.
+         * @param recursive true to build indexes of all objects below too.
+         */
+        void build_key_index(bool recursive = true) {
+            expand();
+            drop_key_index();
+            if (kind_ == JUSJON_JSON_VALUE_OBJECT)
+                ensure_key_index(JUJSON_KEY_INDEX_THRESHOLD);
+            if (!recursive)
+                return;
+            for (auto& child : childs_)
+                child.build_key_index();
+        }
+        /**
+         * @brief Converts the json_value to a string.
+         * @tparam ToStringT_ the type of the string to use.
+         * @tparam ToJSONTraitsT_ the traits class used to define JSON-specific characteristics.
+         * @return the string representation of the json_value.
+         */
+        template<class ToStringT_ = typename string_traits<StringT_>::owning_string_type, class ToJSONTraitsT_ = default_json_traits<typename ToStringT_::value_type>>
+        [[nodiscard]] ToStringT_ to_string() const {
+            typedef json_string_sink<ToStringT_> sink_type;
+            ToStringT_ result;
+            result.reserve(json_writer<sink_type, ToJSONTraitsT_>::size(*this));
+            sink_type sink(result);
+            json_writer<sink_type, ToJSONTraitsT_>(sink).write(*this);
+            return result;
+        }
+        /**
+         * @brief Converts the json_value to a string as to_string() does, keeping the text of arrays and objects of at least minimumSize characters:
+         *        later calls copy the kept text of unchanged ones and write again only the path down to values changed by apply_json_patch or add_child().
+         *        Values whose childs were handed out by non-const get_childs() or find(), and the values above them, keep no text until
+         *        clear_cached_text(), as the childs may be changed at any time; read through const references to keep it. Only for owning string types.
+         * @param minimumSize the size of the shortest text kept, smaller arrays and objects are written each time.
+         * @return the string representation of the json_value.
+         */
+        [[nodiscard]] StringT_ to_string_cached(JUJSON_SIZE_TYPE minimumSize = JUJSON_CACHED_TEXT_MIN_SIZE) const {
+            static_assert(::std::is_same<StringT_, typename string_traits<StringT_>::owning_string_type>::value, "the kept text must be owned");
+            StringT_ result(string_traits<StringT_>::copy(StringT_(), childs_.get_allocator()));
+            result.reserve(data_.capacity()); // the size of the previous text, if any
+            write_cached(result, minimumSize);
+            return result;
+        }
+        /// @brief Checks if to_string_cached kept the text of the json_value. @return True if the text is kept, false otherwise.
+        [[nodiscard]] bool has_cached_text() const noexcept {
+            return (lazy_ & lazy_cached_text) != 0;
+        }
+        /**
+         * @brief Frees the text kept by to_string_cached in the json_value and all values below it, and lets to_string_cached keep the text
+         *        of values whose childs were handed out by non-const get_childs() or find(): call it once references obtained that way are not used.
+         */
+        void clear_cached_text() {
+            if ((lazy_ & lazy_pending) != 0)
+                return; // the text of a lazy container is its input
+            if ((kind_ == JUSJON_JSON_VALUE_ARRAY) || (kind_ == JUSJON_JSON_VALUE_OBJECT))
+                data_ = string_traits<StringT_>::copy(StringT_(), childs_.get_allocator());
+            lazy_ = 0;
+            for (auto& child : childs_)
+                child.clear_cached_text();
+        }
+    };
+    /**
+     * @brief Handler of json_parser::parse that builds a json_value tree. It's what json_parser::parse_json_object_expected uses.
+     * @tparam JSONValueT_ the json_value type to build.
+     */
+    template<class JSONValueT_>
+    struct json_value_builder final {
+        public:
+        typedef JSONValueT_ json_value_type;
+        typedef typename JSONValueT_::allocator_type allocator_type;
+        typedef json_string_pool<typename JSONValueT_::string_type::value_type, allocator_type> string_pool_type;
+
+        private:
+        typedef typename JSONValueT_::string_type string_type;
+        typedef typename string_type::const_iterator string_iterator;
+
+        private:
+        allocator_type allocator_;
+        JUJSON_DEFAULT_CONTAINER<json_value_type, typename ::std::allocator_traits<allocator_type>::template rebind_alloc<json_value_type>> stack_; // open arrays, objects and keys
+        json_value_type result_;
+        json_parser_options options_;
+        JUJSON_SIZE_TYPE skipDepth_; // depth in the skipped container of a lazy value, 0 when building
+        string_iterator skipBegin_; // begin of the skipped container
+        string_pool_type* strings_; // strings of built values are made from the pool if any
+
+        public:
+        /**
+         * @brief Constructs a json_value_builder object.
+         * @param alloc the allocator for built values. @param options the options for built values.
+         * @param strings the pool that keys and short strings are interned in, see json_parser::set_string_pool; nullptr to make strings from the input.
+         */
+        explicit json_value_builder(const allocator_type& alloc = allocator_type(), const json_parser_options& options = json_parser_options(), string_pool_type* strings = nullptr)
+            : allocator_(alloc), stack_(alloc), result_(JUSJON_JSON_VALUE_INVALID, alloc), options_(options), skipDepth_(0), skipBegin_(), strings_(strings) {
+
+        }
+
+        private:
+        bool add_value(json_value_type&& value) {
+            if (stack_.empty()) {
+                result_ = JUJSON_MOVE(value);
+                return true;
+            }
+            if (stack_.back().kind() != JUSJON_JSON_VALUE_KEY) {
+                stack_.back().add_child(JUJSON_MOVE(value));
+                return true;
+            }
+            stack_.back().add_child(JUJSON_MOVE(value));
+            json_value_type keyValue = JUJSON_MOVE(stack_.back());
+            stack_.pop_back();
+            stack_.back().add_child(JUJSON_MOVE(keyValue));
+            return true;
+        }
+        template<class IteratorT_>
+        string_type make_string(IteratorT_ b, IteratorT_ e, bool intern) {
+            if ((strings_ == nullptr) || (!intern && ::std::is_same<string_type, typename string_traits<string_type>::owning_string_type>::value)) // owning strings copy anyway
+                return string_traits<string_type>::make(b, e, allocator_);
+            const auto data = intern ? strings_->intern(b, e) : strings_->store(b, e);
+            return string_traits<string_type>::make(data, data + (e - b), allocator_);
+        }
+        template<class IteratorT_>
+        bool add_scalar(IteratorT_ b, IteratorT_ e, json_value_kind kind) {
+            const bool intern = ((kind != JUSJON_JSON_VALUE_STRING) && (kind != JUSJON_JSON_VALUE_NUMBER)) || (static_cast<JUJSON_SIZE_TYPE>(e - b) <= options_.internLength);
+            return add_value(json_value_type(make_string(b, e, intern), kind, allocator_));
+        }
+        bool close_container() {
+            json_value_type container = JUJSON_MOVE(stack_.back());
+            stack_.pop_back();
+            if (options_.keyIndex)
+                container.build_key_index(false);
+            return add_value(JUJSON_MOVE(container));
+        }
+        // lazy values need ranges of the parsed string, so containers are skipped only when parsing from its iterators.
+        template<class IteratorT_>
+        bool skip_container(IteratorT_ b, ::std::true_type) {
+            if (skipDepth_ == 0) {
+                if (!options_.lazy || stack_.empty()) // the top level is built
+                    return false;
+                skipBegin_ = b;
+            }
+            ++skipDepth_;
+            return true;
+        }
+        template<class IteratorT_>
+        bool skip_container(IteratorT_, ::std::false_type) {
+            return false;
+        }
+        template<class IteratorT_>
+        bool open_container(IteratorT_ b, json_value_kind kind) {
+            if (!skip_container(b, typename ::std::is_same<IteratorT_, string_iterator>::type()))
+                stack_.push_back(json_value_type(kind, allocator_));
+            return true;
+        }
+        bool add_lazy(string_iterator e, json_value_kind kind, ::std::true_type) {
+            const unsigned char lazy = static_cast<unsigned char>(json_value_type::lazy_pending | (options_.keyIndex ? json_value_type::lazy_key_index : 0) |
+                (options_.numberText ? json_value_type::lazy_number_text : 0));
+            return add_value(json_value_type(make_string(skipBegin_, e, false), kind, allocator_, lazy));
+        }
+        template<class IteratorT_>
+        bool add_lazy(IteratorT_, json_value_kind, ::std::false_type) { // never skipped
+            return false;
+        }
+        template<class IteratorT_>
+        bool end_container(IteratorT_ e, json_value_kind kind) {
+            if (skipDepth_ == 0)
+                return close_container();
+            if (--skipDepth_ != 0)
+                return true;
+            return add_lazy(e, kind, typename ::std::is_same<IteratorT_, string_iterator>::type());
+        }
+
+        public:
+        template<class IteratorT_> bool on_null(IteratorT_ b, IteratorT_ e)       {return (skipDepth_ != 0) || add_scalar(b, e, JUSJON_JSON_VALUE_NULL);}
+        template<class IteratorT_> bool on_true(IteratorT_ b, IteratorT_ e)       {return (skipDepth_ != 0) || add_scalar(b, e, JUSJON_JSON_VALUE_TRUE);}
+        template<class IteratorT_> bool on_false(IteratorT_ b, IteratorT_ e)      {return (skipDepth_ != 0) || add_scalar(b, e, JUSJON_JSON_VALUE_FALSE);}
+        template<class IteratorT_> bool on_number(IteratorT_ b, IteratorT_ e) {
+            if (skipDepth_ != 0)
+                return true;
+            if (options_.numberText)
+                return add_scalar(b, e, JUSJON_JSON_VALUE_NUMBER);
+            return add_value(json_value_type(decode_json_number<typename json_value_type::traits_type>(b, e), allocator_));
+        }
+        template<class IteratorT_> bool on_string(IteratorT_ b, IteratorT_ e)     {return (skipDepth_ != 0) || add_scalar(b, e, JUSJON_JSON_VALUE_STRING);}
+        template<class IteratorT_> bool on_key(IteratorT_ b, IteratorT_ e) {
+            if (skipDepth_ == 0)
+                stack_.push_back(json_value_type(make_string(b, e, true), JUSJON_JSON_VALUE_KEY, allocator_));
+            return true;
+        }
+        template<class IteratorT_> bool on_array_begin(IteratorT_ b)              {return open_container(b, JUSJON_JSON_VALUE_ARRAY);}
+        template<class IteratorT_> bool on_array_end(IteratorT_ e)                {return end_container(e, JUSJON_JSON_VALUE_ARRAY);}
+        template<class IteratorT_> bool on_object_begin(IteratorT_ b)             {return open_container(b, JUSJON_JSON_VALUE_OBJECT);}
+        template<class IteratorT_> bool on_object_end(IteratorT_ e)               {return end_container(e, JUSJON_JSON_VALUE_OBJECT);}
+
+        public:
+        /// @brief Takes the built value, the builder can be reused afterwards. @return The built json_value, invalid if nothing was built.
+        [[nodiscard]] json_value_type release() {
+            stack_.clear();
+            skipDepth_ = 0;
+            json_value_type result = JUJSON_MOVE(result_);
+            result_ = json_value_type(JUSJON_JSON_VALUE_INVALID, allocator_); // assigning the root moves it only with the same allocator
+            return result;
+        }
+    };
+    namespace patch {
+        /// @brief Gets childs to change before returning, so json_value::to_string_cached keeps the text of the changed path again on the next call.
+        struct access final {
+            template<class JSONValueT_>
+            static typename JSONValueT_::container_type& childs(JSONValueT_& value) {
+                return value.changed_childs();
+            }
+            template<class JSONValueT_>
+            static const typename JSONValueT_::container_type& childs(const JSONValueT_& value) {
+                return value.get_childs();
+            }
+            template<class JSONValueT_>
+            static void erase(JSONValueT_& value, JUJSON_SIZE_TYPE position) {
+                auto& childs = value.changed_childs();
+                childs.erase(childs.begin() + position);
+                value.drop_key_index(); // the positions of the keys after it changed
+            }
+        };
+        /// @brief Splits a JSON Pointer (RFC 6901) into unescaped tokens. @param pointer the decoded pointer. @param tokens the tokens. @return True if the pointer is valid, false otherwise.
+        template<class StringT_>
+        bool split_pointer(const StringT_& pointer, JUJSON_DEFAULT_CONTAINER<StringT_>& tokens) {
+            typedef typename StringT_::value_type char_type;
+            if (pointer.empty())
+                return true;
+            if (pointer[0] != '/')
+                return false;
+            StringT_ token;
+            for (typename StringT_::size_type i = 1; i <= pointer.size(); ++i) {
+                if ((i == pointer.size()) || (pointer[i] == '/')) {
+                    tokens.push_back(JUJSON_MOVE(token));
+                    token = StringT_();
+                } else if (pointer[i] == '~') {
+                    if ((++i == pointer.size()) || ((pointer[i] != '0') && (pointer[i] != '1')))
+                        return false;
+                    token.push_back((pointer[i] == '0') ? char_type('~') : char_type('/'));
+                } else {
+                    token.push_back(pointer[i]);
+                }
+            }
+            return true;
+        }
+        /// @brief Reads an array index token, digits without leading zeros. @param token the token. @param index the index. @return True for an index, false otherwise.
+        template<class StringT_>
+        bool read_index(const StringT_& token, JUJSON_SIZE_TYPE& index) {
+            if (token.empty() || ((token[0] == '0') && (token.size() != 1)))
+                return false;
+            index = 0;
+            for (const auto c : token) {
+                if ((c < '0') || (c > '9') || (index > (static_cast<JUJSON_SIZE_TYPE>(-1) - 9) / 10))
+                    return false;
+                index = index * 10 + static_cast<JUJSON_SIZE_TYPE>(c - '0');
+            }
+            return true;
+        }
+        /// @brief Finds the member of an object by its unescaped key. @param object the object. @param key the key. @return The position of the member, the number of childs if not found.
+        template<class JSONValueT_>
+        JUJSON_SIZE_TYPE find_member(const JSONValueT_& object, const typename JSONValueT_::string_type& key) {
+            typedef typename JSONValueT_::traits_type json_traits;
+            typedef typename JSONValueT_::string_type string_type;
+            const auto& childs = object.get_childs();
+            bool plain = true; // the key is written the same in JSON, the key index finds it
+            for (const auto c : key)
+                plain = plain && !json_traits::is_escape_spec(c) && !json_traits::is_string_litteral_end(c) && !((c >= 0) && (c < 0x20));
+            if (plain) {
+                const auto found = object.find(key);
+                if (found != childs.end())
+                    return static_cast<JUJSON_SIZE_TYPE>(found - childs.begin());
+            }
+            for (JUJSON_SIZE_TYPE position = 0; position < static_cast<JUJSON_SIZE_TYPE>(childs.size()); ++position) { // keys with escapes
+                const string_type& data = childs[position].data();
+                if ((::std::find_if(data.begin(), data.end(), json_traits::is_escape_spec) != data.end()) &&
+                    (unescape_json_string<string_type, json_traits>(data.begin(), data.end()) == key))
+                    return position;
+            }
+            return static_cast<JUJSON_SIZE_TYPE>(childs.size());
+        }
+        /// @brief Gets the child of a container by token. @param container the container. @param token the token. @return The child, or nullptr if there is none.
+        template<class JSONValueT_>
+        JSONValueT_* find_child(JSONValueT_& container, const typename JSONValueT_::string_type& token) {
+            JUJSON_SIZE_TYPE position = 0;
+            if (container.kind() == JUSJON_JSON_VALUE_ARRAY) {
+                if (!read_index(token, position) || (position >= static_cast<JUJSON_SIZE_TYPE>(access::childs(container).size())))
+                    return nullptr;
+                return &access::childs(container)[position];
+            }
+            if (container.kind() != JUSJON_JSON_VALUE_OBJECT)
+                return nullptr;
+            position = find_member(static_cast<const JSONValueT_&>(container), token);
+            if (position == static_cast<JUJSON_SIZE_TYPE>(access::childs(container).size()))
+                return nullptr;
+            return &access::childs(access::childs(container)[position])[0];
+        }
+        /// @brief Gets the value at the first count tokens, through non-const access for a non-const root. @param root the root. @param tokens the tokens. @param count the number of tokens. @return The value, or nullptr.
+        template<class JSONValueT_, class StringT_>
+        JSONValueT_* resolve(JSONValueT_& root, const JUJSON_DEFAULT_CONTAINER<StringT_>& tokens, ::std::size_t count) {
+            JSONValueT_* result = &root;
+            for (::std::size_t i = 0; (result != nullptr) && (i < count); ++i)
+                result = find_child(*result, tokens[i]);
+            return result;
+        }
+        /// @brief Checks JSON equality: numbers by value, strings decoded, members of objects in any order. @param a the first value. @param b the second value. @return True if equal, false otherwise.
+        template<class JSONValueT_>
+        bool equal(const JSONValueT_& a, const JSONValueT_& b) {
+            typedef typename JSONValueT_::traits_type json_traits;
+            typedef typename JSONValueT_::string_type string_type;
+            if (a.kind() != b.kind())
+                return false;
+            switch (a.kind()) {
+            case JUSJON_JSON_VALUE_STRING:
+                return (a.data() == b.data()) ||
+                    (unescape_json_string<string_type, json_traits>(a.data().begin(), a.data().end()) == unescape_json_string<string_type, json_traits>(b.data().begin(), b.data().end()));
+            case JUSJON_JSON_VALUE_NUMBER:
+                if (a.is_integer() && b.is_integer())
+                    return (a.number().kind == b.number().kind) && (a.number().u == b.number().u);
+                return a.as_double() == b.as_double();
+            case JUSJON_JSON_VALUE_ARRAY: {
+                const auto& childs = a.get_childs();
+                if (childs.size() != b.get_childs().size())
+                    return false;
+                for (::std::size_t i = 0; i < childs.size(); ++i) {
+                    if (!equal(childs[i], b.get_childs()[i]))
+                        return false;
+                }
+                return true;
+            }
+            case JUSJON_JSON_VALUE_OBJECT: {
+                const auto& childs = a.get_childs();
+                if (childs.size() != b.get_childs().size())
+                    return false;
+                for (const auto& member : childs) {
+                    const JUJSON_SIZE_TYPE position = find_member(b, unescape_json_string<string_type, json_traits>(member.data().begin(), member.data().end()));
+                    if ((position == static_cast<JUJSON_SIZE_TYPE>(b.get_childs().size())) || !equal(member.value(), b.get_childs()[position].value()))
+                        return false;
+                }
+                return true;
+            }
+            default:
+                return true;
+            }
+        }
+        /// @brief Adds a value at the tokens: replaces the root or a member, inserts an array element. @param root the root. @param tokens the tokens. @param value the value. @return True on success.
+        template<class JSONValueT_, class StringT_>
+        bool add(JSONValueT_& root, const JUJSON_DEFAULT_CONTAINER<StringT_>& tokens, JSONValueT_&& value) {
+            if (tokens.empty()) {
+                root = JUJSON_MOVE(value);
+                return true;
+            }
+            JSONValueT_* const parent = resolve(root, tokens, tokens.size() - 1);
+            if (parent == nullptr)
+                return false;
+            const StringT_& token = tokens.back();
+            if (parent->kind() == JUSJON_JSON_VALUE_ARRAY) {
+                auto& childs = access::childs(*parent);
+                JUJSON_SIZE_TYPE position = static_cast<JUJSON_SIZE_TYPE>(childs.size());
+                if (((token.size() != 1) || (token[0] != '-')) && (!read_index(token, position) || (position > static_cast<JUJSON_SIZE_TYPE>(childs.size()))))
+                    return false;
+                childs.insert(childs.begin() + position, JUJSON_MOVE(value));
+                return true;
+            }
+            if (parent->kind() != JUSJON_JSON_VALUE_OBJECT)
+                return false;
+            const JUJSON_SIZE_TYPE position = find_member(static_cast<const JSONValueT_&>(*parent), token);
+            if (position != static_cast<JUJSON_SIZE_TYPE>(access::childs(*parent).size())) {
+                access::childs(access::childs(*parent)[position])[0] = JUJSON_MOVE(value);
+                return true;
+            }
+            const typename JSONValueT_::allocator_type alloc(static_cast<const JSONValueT_&>(*parent).get_childs().get_allocator());
+            JSONValueT_ member(string_traits<StringT_>::move(escape_json_string<StringT_, typename JSONValueT_::traits_type>(token.begin(), token.end()), alloc), JUSJON_JSON_VALUE_KEY, alloc);
+            member.add_child(JUJSON_MOVE(value));
+            parent->add_child(JUJSON_MOVE(member));
+            return true;
+        }
+        /// @brief Removes the value at the tokens. @param root the root. @param tokens the tokens. @param removed the removed value. @return True on success, false if there is no value to remove.
+        template<class JSONValueT_, class StringT_>
+        bool remove(JSONValueT_& root, const JUJSON_DEFAULT_CONTAINER<StringT_>& tokens, JSONValueT_& removed) {
+            if (tokens.empty())
+                return false;
+            JSONValueT_* const parent = resolve(root, tokens, tokens.size() - 1);
+            if ((parent == nullptr) || (find_child(*parent, tokens.back()) == nullptr))
+                return false;
+            auto& childs = access::childs(*parent);
+            JUJSON_SIZE_TYPE position = 0;
+            if (parent->kind() == JUSJON_JSON_VALUE_ARRAY) {
+                read_index(tokens.back(), position);
+                removed = JUJSON_MOVE(childs[position]);
+            } else {
+                position = find_member(static_cast<const JSONValueT_&>(*parent), tokens.back());
+                removed = JUJSON_MOVE(access::childs(childs[position])[0]);
+            }
+            access::erase(*parent, position);
+            return true;
+        }
+        /// @brief Gets a member of an operation as decoded text. @param operation the operation. @param key the member name. @param text the text. @return True if the member is a string, false otherwise.
+        template<class JSONValueT_>
+        bool read_text(const JSONValueT_& operation, const typename JSONValueT_::string_type& key, typename JSONValueT_::string_type& text) {
+            const auto found = operation.find(key);
+            if ((found == operation.get_childs().end()) || (found->value().kind() != JUSJON_JSON_VALUE_STRING))
+                return false;
+            text = found->value().decoded_data();
+            return true;
+        }
+    }
+    /**
+     * @brief Applies a JSON Patch (RFC 6902): an array of add, remove, replace, move, copy and test operations, in order.
+     *        The text kept by json_value::to_string_cached is dropped only along the changed paths, and writing the document
+     *        again costs about the size of the change.
+     *        Operations stop at the first failure, the ones before stay applied: patch a copy to keep the document as it was.
+     * @tparam JSONValueT_ the json_value type, with an owning string type.
+     * @param document the document to change.
+     * @param operations the patch, e.g. parsed from [{"op":"replace","path":"/a/0","value":1}].
+     * @return JUJSON_ERROR_CODE_SUCCESS, JUJSON_ERROR_CODE_INVALID_PATCH or JUJSON_ERROR_CODE_TEST_FAILED.
+     */
+    template<class JSONValueT_>
+    [[nodiscard]] error_code apply_json_patch(JSONValueT_& document, const JSONValueT_& operations) {
+        typedef typename JSONValueT_::string_type string_type;
+        typedef typename string_type::value_type char_type;
+        static_assert(::std::is_same<string_type, typename string_traits<string_type>::owning_string_type>::value, "added keys must be owned");
+        if (operations.kind() != JUSJON_JSON_VALUE_ARRAY)
+            return JUJSON_ERROR_CODE_INVALID_PATCH;
+        const char_type opKey[] = {'o', 'p', 0};
+        const char_type pathKey[] = {'p', 'a', 't', 'h', 0};
+        const char_type fromKey[] = {'f', 'r', 'o', 'm', 0};
+        const char_type valueKey[] = {'v', 'a', 'l', 'u', 'e', 0};
+        const typename JSONValueT_::allocator_type alloc(static_cast<const JSONValueT_&>(document).get_childs().get_allocator());
+        for (const auto& operation : operations.get_childs()) {
+            string_type op;
+            string_type pointer;
+            JUJSON_DEFAULT_CONTAINER<string_type> path;
+            if ((operation.kind() != JUSJON_JSON_VALUE_OBJECT) || !patch::read_text(operation, string_type(opKey), op) ||
+                !patch::read_text(operation, string_type(pathKey), pointer) || !patch::split_pointer(pointer, path))
+                return JUJSON_ERROR_CODE_INVALID_PATCH;
+            const auto valueFound = operation.find(valueKey);
+            const JSONValueT_* const value = (valueFound != operation.get_childs().end()) ? &valueFound->value() : nullptr;
+            JUJSON_DEFAULT_CONTAINER<string_type> from;
+            const bool hasFrom = patch::read_text(operation, string_type(fromKey), pointer) && patch::split_pointer(pointer, from);
+            const auto is = [&op](const char* name) {
+                return (op.size() == ::std::char_traits<char>::length(name)) && ::std::equal(op.begin(), op.end(), name);
+            };
+            bool applied = false;
+            if (is("add")) {
+                applied = (value != nullptr) && patch::add(document, path, JSONValueT_(*value, alloc));
+            } else if (is("remove")) {
+                JSONValueT_ removed;
+                applied = patch::remove(document, path, removed);
+            } else if (is("replace")) {
+                JSONValueT_* const target = (value != nullptr) ? patch::resolve(document, path, path.size()) : nullptr;
+                if (target != nullptr)
+                    *target = JSONValueT_(*value, alloc);
+                applied = (target != nullptr);
+            } else if (is("move")) {
+                const bool inside = hasFrom && (from.size() < path.size()) && ::std::equal(from.begin(), from.end(), path.begin()); // into its own childs
+                JSONValueT_ moved;
+                if (hasFrom && (from == path))
+                    applied = (patch::resolve(static_cast<const JSONValueT_&>(document), from, from.size()) != nullptr);
+                else
+                    applied = hasFrom && !inside && patch::remove(document, from, moved) && patch::add(document, path, JUJSON_MOVE(moved));
+            } else if (is("copy")) {
+                const JSONValueT_* const source = hasFrom ? patch::resolve(static_cast<const JSONValueT_&>(document), from, from.size()) : nullptr;
+                applied = (source != nullptr) && patch::add(document, path, JSONValueT_(*source, alloc));
+            } else if (is("test")) {
+                const JSONValueT_* const target = patch::resolve(static_cast<const JSONValueT_&>(document), path, path.size());
+                if ((value != nullptr) && (target != nullptr) && !patch::equal(*target, *value))
+                    return JUJSON_ERROR_CODE_TEST_FAILED;
+                applied = (value != nullptr) && (target != nullptr);
+            }
+            if (!applied)
+                return JUJSON_ERROR_CODE_INVALID_PATCH;
+        }
+        return JUJSON_ERROR_CODE_SUCCESS;
+    }
+    /// @brief Node of json_tape. Values are ranges of the input, containers and keys also know where their subtree ends.
+    struct json_tape_node final {
+        json_value_kind kind;
+        ::std::uint32_t length; // length of the string, key or lexeme; of the whole text for arrays and objects.
+        JUJSON_SIZE_TYPE offset; // offset in the input; of the string content without delimiters for strings and keys.
+        JUJSON_SIZE_TYPE end; // index of the node after the subtree (the next sibling).
+    };
+    /**
+     * @brief Flat representation of a parsed JSON document: one contiguous array of json_tape_node in document order,
+     *        a container is followed by its childs, a key is followed by its value. Strings are not copied,
+     *        so the parsed input must outlive the tape. Filled by json_parser::parse_json_tape_expected.
+     * @tparam StringT_ the type of the string to use.
+     * @tparam JSONTraitsT_ the traits class used to define JSON-specific characteristics.
+     */
+    template <class StringT_, class JSONTraitsT_ = default_json_traits<typename StringT_::value_type>>
+    struct json_tape final {
+        public:
+        typedef typename StringT_::const_iterator const_iterator;
+        typedef JUJSON_DEFAULT_CONTAINER<json_tape_node> container_type;
+        struct cursor;
+
+        /// @brief Range of the child elements of a cursor, usable in range-based for.
+        struct cursor_range final {
+            private:
+            const json_tape* tape_;
+            JUJSON_SIZE_TYPE begin_;
+            JUJSON_SIZE_TYPE end_;
+
+            public:
+            cursor_range(const json_tape* tape, JUJSON_SIZE_TYPE b, JUJSON_SIZE_TYPE e) noexcept : tape_(tape), begin_(b), end_(e) {
+
+            }
+
+            public:
+            [[nodiscard]] cursor begin() const noexcept {
+                return cursor(tape_, begin_);
+            }
+            [[nodiscard]] cursor end() const noexcept {
+                return cursor(tape_, end_);
+            }
+            [[nodiscard]] bool empty() const noexcept {
+                return begin_ == end_;
+            }
+        };
+        /**
+         * @brief Read-only position in the tape. Moving to the next sibling skips the whole subtree in O(1).
+         *        Dereferencing returns the cursor itself, so get_childs() can be iterated like json_value::get_childs().
+         */
+        struct cursor final {
+            public:
+            typedef ::std::forward_iterator_tag iterator_category;
+            typedef cursor value_type;
+            typedef ::std::ptrdiff_t difference_type;
+            typedef const cursor* pointer;
+            typedef const cursor& reference;
+
+            private:
+            const json_tape* tape_;
+            JUJSON_SIZE_TYPE index_;
+
+            public:
+            cursor() noexcept : tape_(nullptr), index_(0) {
+
+            }
+            cursor(const json_tape* tape, JUJSON_SIZE_TYPE index) noexcept : tape_(tape), index_(index) {
+
+            }
+
+            private:
+            [[nodiscard]] const json_tape_node& node() const {
+                JUJSON_ASSERT(is_valid());
+                return tape_->nodes_[index_];
+            }
+            [[nodiscard]] const_iterator data_begin() const {
+                return tape_->base_ + node().offset;
+            }
+            [[nodiscard]] const_iterator data_end() const {
+                return tape_->base_ + node().offset + node().length;
+            }
+
+            public:
+            /// @brief Checks if the cursor points to a node. @return True if the cursor points to a node, false otherwise.
+            [[nodiscard]] bool is_valid() const noexcept {
+                return (tape_ != nullptr) && (index_ < tape_->nodes_.size());
+            }
+            /// @brief Gets the index of the node in the tape. @return The index of the node.
+            [[nodiscard]] JUJSON_SIZE_TYPE index() const noexcept {
+                return index_;
+            }
+            /// @brief Gets the kind of the node. @return The kind of the node, JUSJON_JSON_VALUE_INVALID for invalid cursor.
+            [[nodiscard]] json_value_kind kind() const noexcept {
+                return is_valid() ? tape_->nodes_[index_].kind : JUSJON_JSON_VALUE_INVALID;
+            }
+            /// @brief Gets the data of the node, as json_value::data() would. @return The data of the node.
+            [[nodiscard]] StringT_ data() const {
+                if ((node().kind == JUSJON_JSON_VALUE_ARRAY) || (node().kind == JUSJON_JSON_VALUE_OBJECT))
+                    return StringT_();
+                return string_traits<StringT_>::make(data_begin(), data_end());
+            }
+            /// @brief Gets the data of the node with escape sequences decoded. @return The decoded data of the node.
+            [[nodiscard]] typename string_traits<StringT_>::owning_string_type decoded_data() const {
+                if ((node().kind == JUSJON_JSON_VALUE_ARRAY) || (node().kind == JUSJON_JSON_VALUE_OBJECT))
+                    return typename string_traits<StringT_>::owning_string_type();
+                return unescape_json_string<typename string_traits<StringT_>::owning_string_type, JSONTraitsT_>(data_begin(), data_end());
+            }
+            /// @brief Decodes the number of a JUSJON_JSON_VALUE_NUMBER node. @return The number, JUJSON_NUMBER_KIND_INVALID for other kinds.
+            [[nodiscard]] json_number number() const {
+                if (node().kind != JUSJON_JSON_VALUE_NUMBER)
+                    return json_number();
+                return decode_json_number<JSONTraitsT_>(data_begin(), data_end());
+            }
+            /// @brief Gets the value if kind is equal to JUSJON_JSON_VALUE_KEY. @return A cursor to the value.
+            [[nodiscard]] cursor value() const {
+                if (node().kind != JUSJON_JSON_VALUE_KEY)
+                    JUJSON_ASSERT(false);
+                return cursor(tape_, index_ + 1);
+            }
+            /// @brief Gets the child elements of an array or object, keys for objects. @return A range of cursors to the child elements.
+            [[nodiscard]] cursor_range get_childs() const {
+                if ((node().kind != JUSJON_JSON_VALUE_ARRAY) && (node().kind != JUSJON_JSON_VALUE_OBJECT))
+                    return cursor_range(tape_, node().end, node().end);
+                return cursor_range(tape_, index_ + 1, node().end);
+            }
+            /// @brief Gets the next sibling. @return A cursor to the node after the subtree of this one.
+            [[nodiscard]] cursor next_sibling() const {
+                return cursor(tape_, node().end);
+            }
+            /**
+             * @brief Finds a child element with the specified key, skipping values without visiting them.
+             * @param toFind the key to find.
+             * @return A cursor to the found key, or get_childs().end() if not found. RETURNS KV(KEY/VALUE) NOT A VALUE ITSELF.
+             */
+            [[nodiscard]] cursor find(const StringT_& toFind) const {
+                if (node().kind != JUSJON_JSON_VALUE_OBJECT)
+                    return cursor(tape_, node().end);
+                const JUJSON_SIZE_TYPE size = static_cast<JUJSON_SIZE_TYPE>(toFind.size());
+                for (JUJSON_SIZE_TYPE i = index_ + 1; i != node().end; i = tape_->nodes_[i].end) {
+                    const json_tape_node& key = tape_->nodes_[i];
+                    if ((key.length == size) && ::std::equal(toFind.begin(), toFind.end(), tape_->base_ + key.offset))
+                        return cursor(tape_, i);
+                }
+                return cursor(tape_, node().end);
+            }
+            /**
+             * @brief Converts the subtree to json_value.
+             * @tparam AllocatorT_ the allocator of the json_value.
+             * @param alloc the allocator to use.
+             * @return The json_value equal to what json_parser would produce for the subtree.
+             */
+            template<class AllocatorT_ = ::std::allocator<char>>
+            [[nodiscard]] json_value<StringT_, JSONTraitsT_, AllocatorT_> to_value(const AllocatorT_& alloc = AllocatorT_()) const {
+                typedef json_value<StringT_, JSONTraitsT_, AllocatorT_> json_value_type;
+                switch (kind()) {
+                case JUSJON_JSON_VALUE_ARRAY:
+                case JUSJON_JSON_VALUE_OBJECT: {
+                    json_value_type result(node().kind, alloc);
+                    for (const cursor& i : get_childs())
+                        result.add_child(i.to_value(alloc));
+                    return result;
+                }
+                case JUSJON_JSON_VALUE_KEY: {
+                    json_value_type result(string_traits<StringT_>::make(data_begin(), data_end(), alloc), JUSJON_JSON_VALUE_KEY, alloc);
+                    result.add_child(value().to_value(alloc));
+                    return result;
+                }
+                case JUSJON_JSON_VALUE_INVALID:
+                    return json_value_type();
+                default:
+                    return json_value_type(string_traits<StringT_>::make(data_begin(), data_end(), alloc), node().kind, alloc);
+                }
+                return json_value_type();
+            }
+
+            public:
+            const cursor& operator*() const noexcept {
+                return *this;
+            }
+            const cursor* operator->() const noexcept {
+                return this;
+            }
+            /// @brief Moves to the next sibling.
+            cursor& operator++() {
+                index_ = node().end;
+                return *this;
+            }
+            /// @brief Moves to the next sibling.
+            cursor operator++(int) {
+                cursor result = *this;
+                ++(*this);
+                return result;
+            }
+            [[nodiscard]] bool operator==(const cursor& other) const noexcept {
+                return (tape_ == other.tape_) && (index_ == other.index_);
+            }
+            [[nodiscard]] bool operator!=(const cursor& other) const noexcept {
+                return !(*this == other);
+            }
+        };
+
+        private:
+        const_iterator base_;
+        container_type nodes_;
+
+        public:
+        /// @brief Constructs an empty json_tape.
+        json_tape() : base_(), nodes_() {
+
+        }
+        /// @brief Constructs an empty json_tape over the input. @param base the beginning of the input node offsets are relative to.
+        explicit json_tape(const_iterator base) : base_(base), nodes_() {
+
+        }
+
+        public:
+        /// @brief Checks if the tape holds a parsed value. @return True if the tape is not empty, false otherwise.
+        [[nodiscard]] bool is_valid() const noexcept {
+            return !nodes_.empty();
+        }
+        /// @brief Gets the root node. @return A cursor to the root node, invalid for empty tape.
+        [[nodiscard]] cursor root() const noexcept {
+            return cursor(this, 0);
+        }
+        /// @brief Gets the nodes. @return A reference to the container of nodes.
+        [[nodiscard]] const container_type& nodes() const noexcept {
+            return nodes_;
+        }
+        /// @brief Gets the beginning of the input. @return The beginning iterator node offsets are relative to.
+        [[nodiscard]] const_iterator base() const noexcept {
+            return base_;
+        }
+        /**
+         * @brief Appends a node, its end is set to the node after it. Used by the parser.
+         * @param kind the kind of the node. @param offset the offset in the input. @param length the length of the data.
+         * @return The index of the appended node.
+         */
+        JUJSON_SIZE_TYPE push_node(json_value_kind kind, JUJSON_SIZE_TYPE offset, JUJSON_SIZE_TYPE length) {
+            json_tape_node node;
+            node.kind = kind;
+            node.length = static_cast<::std::uint32_t>(length);
+            node.offset = offset;
+            node.end = nodes_.size() + 1;
+            nodes_.push_back(node);
+            return nodes_.size() - 1;
+        }
+        /// @brief Ends the subtree of the node at the current end of the tape. Used by the parser. @param index the index of the node. @param length the new length of the node.
+        void close_node(JUJSON_SIZE_TYPE index, JUJSON_SIZE_TYPE length) {
+            nodes_[index].end = nodes_.size();
+            nodes_[index].length = static_cast<::std::uint32_t>(length);
+        }
+        /// @brief Removes all nodes.
+        void clear() noexcept {
+            nodes_.clear();
+        }
+        /**
+         * @brief Converts the tape to json_value.
+         * @tparam AllocatorT_ the allocator of the json_value.
+         * @param alloc the allocator to use.
+         * @return The root json_value, invalid for empty tape.
+         */
+        template<class AllocatorT_ = ::std::allocator<char>>
+        [[nodiscard]] json_value<StringT_, JSONTraitsT_, AllocatorT_> to_value(const AllocatorT_& alloc = AllocatorT_()) const {
+            if (!is_valid())
+                return json_value<StringT_, JSONTraitsT_, AllocatorT_>();
+            return root().to_value(alloc);
+        }
+    };
+    /**
+     * @brief Handler of json_parser::parse that fills a json_tape. It's what json_parser::parse_json_tape_expected uses.
+     * @tparam JSONTapeT_ the json_tape type to fill, its base must be the beginning of the parsed input.
+     */
+    template<class JSONTapeT_>
+    struct json_tape_builder final {
+        private:
+        JSONTapeT_& tape_;
+        JUJSON_DEFAULT_CONTAINER<JUJSON_SIZE_TYPE> stack_; // indices of open arrays, objects and keys
+
+        public:
+        /// @brief Constructs a json_tape_builder object. @param tape the tape to append nodes to.
+        explicit json_tape_builder(JSONTapeT_& tape) : tape_(tape), stack_() {
+
+        }
+
+        private:
+        template<class IteratorT_>
+        JUJSON_SIZE_TYPE offset(IteratorT_ i) const {
+            return static_cast<JUJSON_SIZE_TYPE>(i - tape_.base());
+        }
+        static bool fits(JUJSON_SIZE_TYPE length) noexcept { // json_tape_node::length has 32 bits
+            return static_cast<::std::uint64_t>(length) <= UINT32_MAX;
+        }
+        bool end_value() { // closes the key the value belongs to
+            if ((!stack_.empty()) && (tape_.nodes()[stack_.back()].kind == JUSJON_JSON_VALUE_KEY)) {
+                tape_.close_node(stack_.back(), tape_.nodes()[stack_.back()].length);
+                stack_.pop_back();
+            }
+            return true;
+        }
+        template<class IteratorT_>
+        bool add_scalar(IteratorT_ b, IteratorT_ e, json_value_kind kind) {
+            if (!fits(static_cast<JUJSON_SIZE_TYPE>(e - b)))
+                return false;
+            tape_.push_node(kind, offset(b), static_cast<JUJSON_SIZE_TYPE>(e - b));
+            return end_value();
+        }
+        template<class IteratorT_>
+        bool open_container(IteratorT_ b, json_value_kind kind) {
+            stack_.push_back(tape_.push_node(kind, offset(b), 0));
+            return true;
+        }
+        template<class IteratorT_>
+        bool close_container(IteratorT_ e) {
+            const JUJSON_SIZE_TYPE index = stack_.back();
+            stack_.pop_back();
+            if (!fits(offset(e) - tape_.nodes()[index].offset))
+                return false;
+            tape_.close_node(index, offset(e) - tape_.nodes()[index].offset);
+            return end_value();
+        }
+
+        public:
+        template<class IteratorT_> bool on_null(IteratorT_ b, IteratorT_ e)       {return add_scalar(b, e, JUSJON_JSON_VALUE_NULL);}
+        template<class IteratorT_> bool on_true(IteratorT_ b, IteratorT_ e)       {return add_scalar(b, e, JUSJON_JSON_VALUE_TRUE);}
+        template<class IteratorT_> bool on_false(IteratorT_ b, IteratorT_ e)      {return add_scalar(b, e, JUSJON_JSON_VALUE_FALSE);}
+        template<class IteratorT_> bool on_number(IteratorT_ b, IteratorT_ e)     {return add_scalar(b, e, JUSJON_JSON_VALUE_NUMBER);}
+        template<class IteratorT_> bool on_string(IteratorT_ b, IteratorT_ e)     {return add_scalar(b, e, JUSJON_JSON_VALUE_STRING);}
+        template<class IteratorT_> bool on_key(IteratorT_ b, IteratorT_ e) {
+            if (!fits(static_cast<JUJSON_SIZE_TYPE>(e - b)))
+                return false;
+            stack_.push_back(tape_.push_node(JUSJON_JSON_VALUE_KEY, offset(b), static_cast<JUJSON_SIZE_TYPE>(e - b)));
+            return true;
+        }
+        template<class IteratorT_> bool on_array_begin(IteratorT_ b)              {return open_container(b, JUSJON_JSON_VALUE_ARRAY);}
+        template<class IteratorT_> bool on_array_end(IteratorT_ e)                {return close_container(e);}
+        template<class IteratorT_> bool on_object_begin(IteratorT_ b)             {return open_container(b, JUSJON_JSON_VALUE_OBJECT);}
+        template<class IteratorT_> bool on_object_end(IteratorT_ e)               {return close_container(e);}
+    };
+    /**
+     * @brief Node of json_compact_tree, 16 bytes. The childs of a container are contiguous, those of an object are its keys each followed by its value.
+     *        Strings and keys of up to inline_capacity code units are stored in the node, longer ones in the string pool of the tree.
+     *        Literals need nothing but their kind, numbers are stored decoded.
+     * @tparam CharT_ the character type of the strings.
+     */
+    template<class CharT_>
+    struct json_compact_node final {
+        static const JUJSON_SIZE_TYPE inline_capacity = 8 / sizeof(CharT_);
+        static const ::std::uint8_t inline_data = 0x80; // flag of strings and keys stored in the node
+
+        ::std::uint8_t kind; // json_value_kind
+        ::std::uint8_t flags; // json_number_kind of numbers, inline_data
+        ::std::uint16_t reserved;
+        ::std::uint32_t size; // length of strings and keys in code units, number of childs of arrays, of keys of objects
+        union {
+            ::std::uint64_t first; // index of the first child of arrays and objects
+            const CharT_* text; // characters of long strings and keys
+            CharT_ chars[inline_capacity]; // characters of short strings and keys
+            ::std::int64_t i; // numbers, as in json_number
+            ::std::uint64_t u;
+            double d;
+        };
+    };
+    template<class JSONCompactTreeT_> struct json_compact_builder;
+    /**
+     * @brief Read-only tree of 16-byte nodes, about a fifth of json_value: a node holds its kind and either its short string, its number,
+     *        or where its string or its childs are. Nodes are in one array and childs of a container are contiguous, so childs are counted and
+     *        indexed in O(1). Strings are copied out of the input, keys are interned. Filled by json_parser::parse_json_compact_expected.
+     *        Numbers are decoded only, data() of numbers is empty as with json_parser_options::numberText false.
+     * @tparam StringT_ the type of the string to use.
+     * @tparam JSONTraitsT_ the traits class used to define JSON-specific characteristics.
+     */
+    template <class StringT_, class JSONTraitsT_ = default_json_traits<typename StringT_::value_type>>
+    struct json_compact_tree final {
+        public:
+        typedef typename StringT_::value_type char_type;
+        typedef JSONTraitsT_ traits_type;
+        typedef json_compact_node<char_type> node_type;
+        typedef JUJSON_DEFAULT_CONTAINER<node_type> container_type;
+        struct cursor;
+
+        /// @brief Range of the child elements of a cursor, usable in range-based for.
+        struct cursor_range final {
+            private:
+            const json_compact_tree* tree_;
+            JUJSON_SIZE_TYPE begin_;
+            JUJSON_SIZE_TYPE end_;
+
+            public:
+            cursor_range(const json_compact_tree* tree, JUJSON_SIZE_TYPE b, JUJSON_SIZE_TYPE e) noexcept : tree_(tree), begin_(b), end_(e) {
+
+            }
+
+            public:
+            [[nodiscard]] cursor begin() const noexcept {
+                return cursor(tree_, begin_);
+            }
+            [[nodiscard]] cursor end() const noexcept {
+                return cursor(tree_, end_);
+            }
+            [[nodiscard]] bool empty() const noexcept {
+                return begin_ == end_;
+            }
+            /// @brief Gets the number of child elements, keys for objects. @return The number of child elements.
+            [[nodiscard]] JUJSON_SIZE_TYPE size() const noexcept {
+                return empty() ? 0 : (end_ - begin_) / ((tree_->nodes_[begin_].kind == JUSJON_JSON_VALUE_KEY) ? 2 : 1);
+            }
+        };
+        /// @brief Read-only position in the tree, with the accessors of json_value. Moving to the next sibling skips the value of a key.
+        struct cursor final {
+            public:
+            typedef ::std::forward_iterator_tag iterator_category;
+            typedef cursor value_type;
+            typedef ::std::ptrdiff_t difference_type;
+            typedef const cursor* pointer;
+            typedef const cursor& reference;
+
+            private:
+            const json_compact_tree* tree_;
+            JUJSON_SIZE_TYPE index_;
+
+            public:
+            cursor() noexcept : tree_(nullptr), index_(0) {
+
+            }
+            cursor(const json_compact_tree* tree, JUJSON_SIZE_TYPE index) noexcept : tree_(tree), index_(index) {
+
+            }
+
+            private:
+            [[nodiscard]] const node_type& node() const {
+                JUJSON_ASSERT(is_valid());
+                return tree_->nodes_[index_];
+            }
+            [[nodiscard]] const char_type* chars() const {
+                const node_type& n = node();
+                return ((n.flags & node_type::inline_data) != 0) ? n.chars : n.text;
+            }
+            [[nodiscard]] JUJSON_SIZE_TYPE childs_end() const {
+                const node_type& n = node();
+                return static_cast<JUJSON_SIZE_TYPE>(n.first) + ((n.kind == JUSJON_JSON_VALUE_OBJECT) ? n.size * 2 : n.size);
+            }
+
+            public:
+            /// @brief Checks if the cursor points to a node. @return True if the cursor points to a node, false otherwise.
+            [[nodiscard]] bool is_valid() const noexcept {
+                return (tree_ != nullptr) && (index_ < tree_->nodes_.size());
+            }
+            /// @brief Gets the index of the node in the tree. @return The index of the node.
+            [[nodiscard]] JUJSON_SIZE_TYPE index() const noexcept {
+                return index_;
+            }
+            /// @brief Gets the kind of the node. @return The kind of the node, JUSJON_JSON_VALUE_INVALID for invalid cursor.
+            [[nodiscard]] json_value_kind kind() const noexcept {
+                return is_valid() ? static_cast<json_value_kind>(tree_->nodes_[index_].kind) : JUSJON_JSON_VALUE_INVALID;
+            }
+            /// @brief Gets the data of the node, as json_value::data() would; empty for numbers and containers. @return The data of the node.
+            [[nodiscard]] StringT_ data() const {
+                switch (node().kind) {
+                case JUSJON_JSON_VALUE_STRING:
+                case JUSJON_JSON_VALUE_KEY:
+                    return string_traits<StringT_>::make(chars(), chars() + node().size);
+                case JUSJON_JSON_VALUE_NULL:
+                case JUSJON_JSON_VALUE_TRUE:
+                case JUSJON_JSON_VALUE_FALSE:
+                    return literal(static_cast<json_value_kind>(node().kind));
+                default:
+                    return StringT_();
+                }
+            }
+            /// @brief Gets the data of the node with escape sequences decoded. @return The decoded data of the node.
+            [[nodiscard]] typename string_traits<StringT_>::owning_string_type decoded_data() const {
+                const StringT_ result = data();
+                return unescape_json_string<typename string_traits<StringT_>::owning_string_type, JSONTraitsT_>(result.begin(), result.end());
+            }
+            /// @brief Gets the number of a JUSJON_JSON_VALUE_NUMBER node. @return The number, JUJSON_NUMBER_KIND_INVALID for other kinds.
+            [[nodiscard]] json_number number() const {
+                json_number result;
+                const node_type& n = node();
+                if (n.kind == JUSJON_JSON_VALUE_NUMBER) {
+                    result.kind = static_cast<json_number_kind>(n.flags);
+                    result.u = n.u;
+                }
+                return result;
+            }
+            /// @brief Gets the number of child elements, keys for objects. @return The number of childs, 0 for other kinds.
+            [[nodiscard]] JUJSON_SIZE_TYPE size() const {
+                const node_type& n = node();
+                return ((n.kind == JUSJON_JSON_VALUE_ARRAY) || (n.kind == JUSJON_JSON_VALUE_OBJECT)) ? n.size : 0;
+            }
+            /// @brief Gets a child element in O(1). @param position the position of the child, less than size(). @return A cursor to the child, a key for objects.
+            [[nodiscard]] cursor child(JUJSON_SIZE_TYPE position) const {
+                const node_type& n = node();
+                JUJSON_ASSERT(((n.kind == JUSJON_JSON_VALUE_ARRAY) || (n.kind == JUSJON_JSON_VALUE_OBJECT)) && (position < n.size));
+                return cursor(tree_, static_cast<JUJSON_SIZE_TYPE>(n.first) + ((n.kind == JUSJON_JSON_VALUE_OBJECT) ? position * 2 : position));
+            }
+            /// @brief Gets the value if kind is equal to JUSJON_JSON_VALUE_KEY. @return A cursor to the value.
+            [[nodiscard]] cursor value() const {
+                JUJSON_ASSERT(node().kind == JUSJON_JSON_VALUE_KEY);
+                return cursor(tree_, index_ + 1);
+            }
+            /// @brief Gets the child elements of an array or object, keys for objects. @return A range of cursors to the child elements.
+            [[nodiscard]] cursor_range get_childs() const {
+                const node_type& n = node();
+                if ((n.kind != JUSJON_JSON_VALUE_ARRAY) && (n.kind != JUSJON_JSON_VALUE_OBJECT))
+                    return cursor_range(tree_, 0, 0);
+                return cursor_range(tree_, static_cast<JUJSON_SIZE_TYPE>(n.first), childs_end());
+            }
+            /**
+             * @brief Finds a child element with the specified key, comparing the keys stored next to each other.
+             * @param toFind the key to find.
+             * @return A cursor to the found key, or get_childs().end() if not found. RETURNS KV(KEY/VALUE) NOT A VALUE ITSELF.
+             */
+            [[nodiscard]] cursor find(const StringT_& toFind) const {
+                if (node().kind != JUSJON_JSON_VALUE_OBJECT)
+                    return get_childs().end();
+                const JUJSON_SIZE_TYPE end = childs_end();
+                for (JUJSON_SIZE_TYPE i = static_cast<JUJSON_SIZE_TYPE>(node().first); i != end; i += 2) {
+                    const node_type& key = tree_->nodes_[i];
+                    if ((key.size == toFind.size()) && ::std::equal(toFind.begin(), toFind.end(), ((key.flags & node_type::inline_data) != 0) ? key.chars : key.text))
+                        return cursor(tree_, i);
+                }
+                return cursor(tree_, end);
+            }
+            /**
+             * @brief Converts the subtree to json_value.
+             * @tparam AllocatorT_ the allocator of the json_value.
+             * @param alloc the allocator to use.
+             * @return The json_value equal to the subtree, numbers without text.
+             */
+            template<class AllocatorT_ = ::std::allocator<char>>
+            [[nodiscard]] json_value<StringT_, JSONTraitsT_, AllocatorT_> to_value(const AllocatorT_& alloc = AllocatorT_()) const {
+                typedef json_value<StringT_, JSONTraitsT_, AllocatorT_> json_value_type;
+                if (!is_valid())
+                    return json_value_type();
+                const json_value_kind k = kind();
+                switch (k) {
+                case JUSJON_JSON_VALUE_ARRAY:
+                case JUSJON_JSON_VALUE_OBJECT: {
+                    json_value_type result(k, alloc);
+                    result.changed_childs().reserve(size());
+                    for (const auto& child : get_childs())
+                        result.add_child(child.to_value(alloc));
+                    return result;
+                }
+                case JUSJON_JSON_VALUE_KEY: {
+                    json_value_type result(string_traits<StringT_>::copy(data(), alloc), k, alloc);
+                    result.add_child(value().to_value(alloc));
+                    return result;
+                }
+                case JUSJON_JSON_VALUE_NUMBER:
+                    return json_value_type(string_traits<StringT_>::copy(StringT_(), alloc), number(), alloc);
+                default:
+                    return json_value_type(string_traits<StringT_>::copy(data(), alloc), k, alloc);
+                }
+            }
+
+            public:
+            const cursor& operator*() const noexcept {
+                return *this;
+            }
+            const cursor* operator->() const noexcept {
+                return this;
+            }
+            /// @brief Moves to the next sibling, past the value of a key.
+            cursor& operator++() {
+                index_ += (node().kind == JUSJON_JSON_VALUE_KEY) ? 2 : 1;
+                return *this;
+            }
+            /// @brief Moves to the next sibling, past the value of a key.
+            cursor operator++(int) {
+                cursor result = *this;
+                ++(*this);
+                return result;
+            }
+            [[nodiscard]] bool operator==(const cursor& other) const noexcept {
+                return (tree_ == other.tree_) && (index_ == other.index_);
+            }
+            [[nodiscard]] bool operator!=(const cursor& other) const noexcept {
+                return !(*this == other);
+            }
+        };
+
+        private:
+        container_type nodes_;
+        json_string_pool<char_type> strings_; // long strings and keys
+
+        template<class> friend struct json_compact_builder;
+
+        public:
+        /// @brief Constructs an empty json_compact_tree.
+        json_compact_tree() : nodes_(), strings_() {
+
+        }
+        json_compact_tree(json_compact_tree&&) = default;
+        json_compact_tree& operator=(json_compact_tree&&) = default;
+
+        private:
+        static StringT_ literal(json_value_kind kind) {
+            static const char_type nullText[] = {'n', 'u', 'l', 'l'};
+            static const char_type trueText[] = {'t', 'r', 'u', 'e'};
+            static const char_type falseText[] = {'f', 'a', 'l', 's', 'e'};
+            switch (kind) {
+            case JUSJON_JSON_VALUE_NULL:    return string_traits<StringT_>::make(nullText, nullText + 4);
+            case JUSJON_JSON_VALUE_TRUE:    return string_traits<StringT_>::make(trueText, trueText + 4);
+            default:                        return string_traits<StringT_>::make(falseText, falseText + 5);
+            }
+        }
+
+        public:
+        /// @brief Checks if the tree holds a parsed value. @return True if the tree is not empty, false otherwise.
+        [[nodiscard]] bool is_valid() const noexcept {
+            return !nodes_.empty();
+        }
+        /// @brief Gets the root node. @return A cursor to the root node, invalid for empty tree.
+        [[nodiscard]] cursor root() const noexcept {
+            return cursor(this, 0);
+        }
+        /// @brief Gets the nodes. @return A reference to the container of nodes.
+        [[nodiscard]] const container_type& nodes() const noexcept {
+            return nodes_;
+        }
+        /// @brief Removes all nodes and strings.
+        void clear() noexcept {
+            nodes_.clear();
+            strings_.clear();
+        }
+        /**
+         * @brief Converts the tree to json_value.
+         * @tparam AllocatorT_ the allocator of the json_value.
+         * @param alloc the allocator to use.
+         * @return The root json_value, invalid for empty tree.
+         */
+        template<class AllocatorT_ = ::std::allocator<char>>
+        [[nodiscard]] json_value<StringT_, JSONTraitsT_, AllocatorT_> to_value(const AllocatorT_& alloc = AllocatorT_()) const {
+            return root().to_value(alloc);
+        }
+    };
+    /**
+     * @brief Handler of json_parser::parse that fills a json_compact_tree. Childs of open containers wait on a stack
+     *        and are moved next to each other into the tree when their container ends, so the root is placed first and its childs last.
+     * @tparam JSONCompactTreeT_ the json_compact_tree type to fill.
+     */
+    template<class JSONCompactTreeT_>
+    struct json_compact_builder final {
+        private:
+        typedef typename JSONCompactTreeT_::node_type node_type;
+        typedef typename JSONCompactTreeT_::char_type char_type;
+
+        private:
+        JSONCompactTreeT_& tree_;
+        JUJSON_DEFAULT_CONTAINER<node_type> pending_; // childs of open containers, keys followed by their values
+        JUJSON_DEFAULT_CONTAINER<JUJSON_SIZE_TYPE> stack_; // positions of the first childs of open containers in pending_
+
+        public:
+        /// @brief Constructs a json_compact_builder object. @param tree the tree to fill, cleared first.
+        explicit json_compact_builder(JSONCompactTreeT_& tree) : tree_(tree), pending_(), stack_() {
+            tree_.clear();
+            tree_.nodes_.push_back(node_type()); // the root
+        }
+
+        private:
+        static node_type make_node(json_value_kind kind) {
+            node_type result;
+            result.kind = static_cast<::std::uint8_t>(kind);
+            result.flags = 0;
+            result.reserved = 0;
+            result.size = 0;
+            result.u = 0;
+            return result;
+        }
+        static bool fits(JUJSON_SIZE_TYPE size) noexcept { // node_type::size has 32 bits
+            return static_cast<::std::uint64_t>(size) <= UINT32_MAX;
+        }
+        bool add(const node_type& node) {
+            if (stack_.empty())
+                tree_.nodes_[0] = node;
+            else
+                pending_.push_back(node);
+            return true;
+        }
+        template<class IteratorT_>
+        node_type make_string(IteratorT_ b, IteratorT_ e, json_value_kind kind) {
+            node_type result = make_node(kind);
+            result.size = static_cast<::std::uint32_t>(e - b);
+            if (result.size <= node_type::inline_capacity) {
+                result.flags = node_type::inline_data;
+                ::std::copy(b, e, result.chars);
+            } else {
+                result.text = (kind == JUSJON_JSON_VALUE_KEY) ? tree_.strings_.intern(b, e) : tree_.strings_.store(b, e);
+            }
+            return result;
+        }
+        bool close_container(json_value_kind kind) {
+            const JUJSON_SIZE_TYPE start = stack_.back();
+            stack_.pop_back();
+            node_type container = make_node(kind);
+            const JUJSON_SIZE_TYPE count = static_cast<JUJSON_SIZE_TYPE>(pending_.size()) - start;
+            if (!fits((kind == JUSJON_JSON_VALUE_OBJECT) ? count / 2 : count))
+                return false;
+            container.size = static_cast<::std::uint32_t>((kind == JUSJON_JSON_VALUE_OBJECT) ? count / 2 : count);
+            container.first = tree_.nodes_.size();
+            tree_.nodes_.insert(tree_.nodes_.end(), pending_.begin() + start, pending_.end());
+            pending_.resize(start);
+            return add(container);
+        }
+
+        public:
+        template<class IteratorT_> bool on_null(IteratorT_, IteratorT_)           {return add(make_node(JUSJON_JSON_VALUE_NULL));}
+        template<class IteratorT_> bool on_true(IteratorT_, IteratorT_)           {return add(make_node(JUSJON_JSON_VALUE_TRUE));}
+        template<class IteratorT_> bool on_false(IteratorT_, IteratorT_)          {return add(make_node(JUSJON_JSON_VALUE_FALSE));}
+        template<class IteratorT_> bool on_number(IteratorT_ b, IteratorT_ e) {
+            const json_number number = decode_json_number<typename JSONCompactTreeT_::traits_type>(b, e);
+            node_type result = make_node(JUSJON_JSON_VALUE_NUMBER);
+            result.flags = static_cast<::std::uint8_t>(number.kind);
+            result.u = number.u;
+            return add(result);
+        }
+        template<class IteratorT_> bool on_string(IteratorT_ b, IteratorT_ e)     {return fits(static_cast<JUJSON_SIZE_TYPE>(e - b)) && add(make_string(b, e, JUSJON_JSON_VALUE_STRING));}
+        template<class IteratorT_> bool on_key(IteratorT_ b, IteratorT_ e) {
+            if (!fits(static_cast<JUJSON_SIZE_TYPE>(e - b)))
+                return false;
+            pending_.push_back(make_string(b, e, JUSJON_JSON_VALUE_KEY));
+            return true;
+        }
+        template<class IteratorT_> bool on_array_begin(IteratorT_) {
+            stack_.push_back(pending_.size());
+            return true;
+        }
+        template<class IteratorT_> bool on_array_end(IteratorT_)                  {return close_container(JUSJON_JSON_VALUE_ARRAY);}
+        template<class IteratorT_> bool on_object_begin(IteratorT_) {
+            stack_.push_back(pending_.size());
+            return true;
+        }
+        template<class IteratorT_> bool on_object_end(IteratorT_)                 {return close_container(JUSJON_JSON_VALUE_OBJECT);}
+    };
+    /// @brief Header of a json binary snapshot, see encode_json_binary. Followed by the nodes, then by the string area.
+    struct json_binary_header final {
+        char magic[4]; // "JUJB"
+        ::std::uint32_t byteOrder; // 0x01020304 as written by the encoding machine
+        ::std::uint16_t version;
+        ::std::uint16_t charSize; // size of a code unit of the string area
+        ::std::uint32_t reserved;
+        ::std::uint64_t nodeCount;
+        ::std::uint64_t textSize; // size of the string area in code units
+    };
+    /// @brief Node of a json binary snapshot, the nodes are in document order like json_tape_node.
+    struct json_binary_node final {
+        ::std::uint8_t kind; // json_value_kind
+        ::std::uint8_t numberKind; // json_number_kind of numbers
+        ::std::uint16_t reserved;
+        ::std::uint32_t length; // length of the data in code units; number of childs for arrays and objects
+        ::std::uint64_t offset; // offset of the data in the string area, in code units
+        ::std::uint64_t extra; // index of the node after the subtree for arrays, objects and keys; bits of the decoded number for numbers
+    };
+    static_assert(sizeof(json_binary_header) == 32, "json_binary_header must be packed");
+    static_assert(sizeof(json_binary_node) == 24, "json_binary_node must be packed");
+    namespace binary {
+        static const ::std::uint16_t version = 1;
+        static const ::std::uint32_t byte_order = 0x01020304u;
+
+        // appends the nodes of the subtree of value and its data, false if a string does not fit a node.
+        template<class JSONValueT_, class CharT_>
+        bool encode(const JSONValueT_& value, JUJSON_DEFAULT_CONTAINER<json_binary_node>& nodes, ::std::basic_string<CharT_>& text) {
+            const ::std::size_t index = nodes.size();
+            json_binary_node node = {static_cast<::std::uint8_t>(value.kind()), 0, 0, 0, 0, 0};
+            nodes.push_back(node);
+            switch (value.kind()) {
+            case JUSJON_JSON_VALUE_ARRAY:
+            case JUSJON_JSON_VALUE_OBJECT:
+                for (const auto& child : value.get_childs()) {
+                    if (!encode(child, nodes, text))
+                        return false;
+                }
+                nodes[index].length = static_cast<::std::uint32_t>(value.get_childs().size());
+                nodes[index].extra = nodes.size();
+                return true;
+            case JUSJON_JSON_VALUE_NUMBER:
+                nodes[index].numberKind = static_cast<::std::uint8_t>(value.number().kind);
+                nodes[index].extra = value.number().u;
+                break;
+            default:
+                break;
+            }
+            const auto& data = value.data();
+            if (static_cast<::std::uint64_t>(data.size()) > UINT32_MAX)
+                return false;
+            nodes[index].offset = text.size();
+            nodes[index].length = static_cast<::std::uint32_t>(data.size());
+            text.append(data.begin(), data.end());
+            if (value.kind() == JUSJON_JSON_VALUE_KEY) {
+                if (!encode(value.value(), nodes, text))
+                    return false;
+                nodes[index].extra = nodes.size();
+            }
+            return true;
+        }
+    }
+    /**
+     * @brief Encodes a json_value tree as a binary snapshot, to be reloaded by json_binary_view or decode_json_binary without parsing.
+     *        Nodes hold decoded numbers, string lengths and child counts, strings are kept as in data() in one area. The snapshot is
+     *        meant for the machine that wrote it: the byte order and the size of the code units are checked when loading it.
+     *        Lazy containers are parsed first.
+     * @tparam JSONValueT_ the json_value type to encode.
+     * @param value the value to encode.
+     * @return The bytes of the snapshot, empty for invalid values and strings longer than 4G code units.
+     */
+    template<class JSONValueT_>
+    [[nodiscard]] ::std::string encode_json_binary(const JSONValueT_& value) {
+        typedef typename JSONValueT_::string_type::value_type char_type;
+        JUJSON_DEFAULT_CONTAINER<json_binary_node> nodes;
+        ::std::basic_string<char_type> text;
+        if (!value.is_valid() || !binary::encode(value, nodes, text))
+            return ::std::string();
+        json_binary_header header;
+        ::std::memcpy(header.magic, "JUJB", 4);
+        header.byteOrder = binary::byte_order;
+        header.version = binary::version;
+        header.charSize = static_cast<::std::uint16_t>(sizeof(char_type));
+        header.reserved = 0;
+        header.nodeCount = nodes.size();
+        header.textSize = text.size();
+        ::std::string result;
+        result.reserve(sizeof(header) + nodes.size() * sizeof(json_binary_node) + text.size() * sizeof(char_type));
+        result.append(reinterpret_cast<const char*>(&header), sizeof(header));
+        if (!nodes.empty())
+            result.append(reinterpret_cast<const char*>(nodes.data()), nodes.size() * sizeof(json_binary_node));
+        result.append(reinterpret_cast<const char*>(text.data()), text.size() * sizeof(char_type));
+        return result;
+    }
+    /**
+     * @brief Read-only view of a json binary snapshot, e.g. of a json_mapped_file: open() validates the whole snapshot once,
+     *        then nodes are read in place. With std::string_view, data() never copies and the snapshot must outlive the values.
+     * @tparam StringT_ the type of the string to use, its code units must have the size of those of the snapshot.
+     * @tparam JSONTraitsT_ the traits class used to define JSON-specific characteristics.
+     */
+    template<class StringT_, class JSONTraitsT_>
+    struct json_binary_view final {
+        public:
+        typedef typename StringT_::value_type char_type;
+        struct cursor;
+
+        /// @brief Range of the child elements of a cursor, usable in range-based for.
+        struct cursor_range final {
+            private:
+            const json_binary_view* view_;
+            JUJSON_SIZE_TYPE begin_;
+            JUJSON_SIZE_TYPE end_;
+
+            public:
+            cursor_range(const json_binary_view* view, JUJSON_SIZE_TYPE b, JUJSON_SIZE_TYPE e) noexcept : view_(view), begin_(b), end_(e) {
+
+            }
+
+            public:
+            [[nodiscard]] cursor begin() const noexcept {
+                return cursor(view_, begin_);
+            }
+            [[nodiscard]] cursor end() const noexcept {
+                return cursor(view_, end_);
+            }
+            [[nodiscard]] bool empty() const noexcept {
+                return begin_ == end_;
+            }
+        };
+        /// @brief Read-only position in the snapshot, like json_tape::cursor. Numbers are decoded already, childs are counted.
+        struct cursor final {
+            public:
+            typedef ::std::forward_iterator_tag iterator_category;
+            typedef cursor value_type;
+            typedef ::std::ptrdiff_t difference_type;
+            typedef const cursor* pointer;
+            typedef const cursor& reference;
+
+            private:
+            const json_binary_view* view_;
+            JUJSON_SIZE_TYPE index_;
+
+            public:
+            cursor() noexcept : view_(nullptr), index_(0) {
+
+            }
+            cursor(const json_binary_view* view, JUJSON_SIZE_TYPE index) noexcept : view_(view), index_(index) {
+
+            }
+
+            private:
+            [[nodiscard]] const json_binary_node& node() const {
+                JUJSON_ASSERT(is_valid());
+                return view_->nodes_[index_];
+            }
+            [[nodiscard]] JUJSON_SIZE_TYPE end_index() const {
+                JUJSON_ASSERT(is_valid());
+                return view_->end_of(index_);
+            }
+
+            public:
+            /// @brief Checks if the cursor points to a node. @return True if the cursor points to a node, false otherwise.
+            [[nodiscard]] bool is_valid() const noexcept {
+                return (view_ != nullptr) && (index_ < view_->nodeCount_);
+            }
+            /// @brief Gets the index of the node in the snapshot. @return The index of the node.
+            [[nodiscard]] JUJSON_SIZE_TYPE index() const noexcept {
+                return index_;
+            }
+            /// @brief Gets the kind of the node. @return The kind of the node, JUSJON_JSON_VALUE_INVALID for invalid cursor.
+            [[nodiscard]] json_value_kind kind() const noexcept {
+                return is_valid() ? static_cast<json_value_kind>(view_->nodes_[index_].kind) : JUSJON_JSON_VALUE_INVALID;
+            }
+            /// @brief Gets the data of the node, as json_value::data() would. @return The data of the node.
+            [[nodiscard]] StringT_ data() const {
+                const json_binary_node& n = node();
+                if ((n.kind == JUSJON_JSON_VALUE_ARRAY) || (n.kind == JUSJON_JSON_VALUE_OBJECT))
+                    return StringT_();
+                return string_traits<StringT_>::make(view_->text_ + n.offset, view_->text_ + n.offset + n.length);
+            }
+            /// @brief Gets the data of the node with escape sequences decoded. @return The decoded data of the node.
+            [[nodiscard]] typename string_traits<StringT_>::owning_string_type decoded_data() const {
+                const json_binary_node& n = node();
+                if ((n.kind == JUSJON_JSON_VALUE_ARRAY) || (n.kind == JUSJON_JSON_VALUE_OBJECT))
+                    return typename string_traits<StringT_>::owning_string_type();
+                return unescape_json_string<typename string_traits<StringT_>::owning_string_type, JSONTraitsT_>(view_->text_ + n.offset, view_->text_ + n.offset + n.length);
+            }
+            /// @brief Gets the number of a JUSJON_JSON_VALUE_NUMBER node, decoded when encoding. @return The number, JUJSON_NUMBER_KIND_INVALID for other kinds.
+            [[nodiscard]] json_number number() const {
+                json_number result;
+                const json_binary_node& n = node();
+                if (n.kind == JUSJON_JSON_VALUE_NUMBER) {
+                    result.kind = static_cast<json_number_kind>(n.numberKind);
+                    result.u = n.extra;
+                }
+                return result;
+            }
+            /// @brief Gets the number of child elements of an array or object in O(1). @return The number of childs, 0 for other kinds.
+            [[nodiscard]] JUJSON_SIZE_TYPE size() const {
+                const json_binary_node& n = node();
+                return ((n.kind == JUSJON_JSON_VALUE_ARRAY) || (n.kind == JUSJON_JSON_VALUE_OBJECT)) ? n.length : 0;
+            }
+            /// @brief Gets the value if kind is equal to JUSJON_JSON_VALUE_KEY. @return A cursor to the value.
+            [[nodiscard]] cursor value() const {
+                JUJSON_ASSERT(node().kind == JUSJON_JSON_VALUE_KEY);
+                return cursor(view_, index_ + 1);
+            }
+            /// @brief Gets the child elements of an array or object, keys for objects. @return A range of cursors to the child elements.
+            [[nodiscard]] cursor_range get_childs() const {
+                const JUJSON_SIZE_TYPE end = end_index();
+                if ((node().kind != JUSJON_JSON_VALUE_ARRAY) && (node().kind != JUSJON_JSON_VALUE_OBJECT))
+                    return cursor_range(view_, end, end);
+                return cursor_range(view_, index_ + 1, end);
+            }
+            /// @brief Gets the next sibling. @return A cursor to the node after the subtree of this one.
+            [[nodiscard]] cursor next_sibling() const {
+                return cursor(view_, end_index());
+            }
+            /**
+             * @brief Finds a child element with the specified key, skipping values without visiting them.
+             * @param toFind the key to find.
+             * @return A cursor to the found key, or get_childs().end() if not found. RETURNS KV(KEY/VALUE) NOT A VALUE ITSELF.
+             */
+            [[nodiscard]] cursor find(const StringT_& toFind) const {
+                const JUJSON_SIZE_TYPE end = end_index();
+                if (node().kind != JUSJON_JSON_VALUE_OBJECT)
+                    return cursor(view_, end);
+                for (JUJSON_SIZE_TYPE i = index_ + 1; i != end; i = static_cast<JUJSON_SIZE_TYPE>(view_->nodes_[i].extra)) {
+                    const json_binary_node& key = view_->nodes_[i];
+                    if ((key.length == toFind.size()) && ::std::equal(toFind.begin(), toFind.end(), view_->text_ + key.offset))
+                        return cursor(view_, i);
+                }
+                return cursor(view_, end);
+            }
+            /**
+             * @brief Converts the subtree to json_value, without parsing or decoding numbers again.
+             * @tparam AllocatorT_ the allocator of the json_value.
+             * @param alloc the allocator to use.
+             * @return The json_value equal to the encoded one.
+             */
+            template<class AllocatorT_ = ::std::allocator<char>>
+            [[nodiscard]] json_value<StringT_, JSONTraitsT_, AllocatorT_> to_value(const AllocatorT_& alloc = AllocatorT_()) const {
+                if (!is_valid())
+                    return json_value<StringT_, JSONTraitsT_, AllocatorT_>();
+                return view_->make_value(index_, alloc);
+            }
+
+            public:
+            const cursor& operator*() const noexcept {
+                return *this;
+            }
+            const cursor* operator->() const noexcept {
+                return this;
+            }
+            /// @brief Moves to the next sibling.
+            cursor& operator++() {
+                index_ = end_index();
+                return *this;
+            }
+            /// @brief Moves to the next sibling.
+            cursor operator++(int) {
+                cursor result = *this;
+                ++(*this);
+                return result;
+            }
+            [[nodiscard]] bool operator==(const cursor& other) const noexcept {
+                return (view_ == other.view_) && (index_ == other.index_);
+            }
+            [[nodiscard]] bool operator!=(const cursor& other) const noexcept {
+                return !(*this == other);
+            }
+        };
+
+        private:
+        const json_binary_node* nodes_;
+        const char_type* text_;
+        JUJSON_SIZE_TYPE nodeCount_;
+        error_code lastError_;
+
+        public:
+        /// @brief Constructs an empty json_binary_view.
+        json_binary_view() noexcept : nodes_(nullptr), text_(nullptr), nodeCount_(0), lastError_(JUJSON_ERROR_CODE_SUCCESS) {
+
+        }
+        /// @brief Constructs a json_binary_view of a snapshot, see open(). @param data the snapshot. @param size the size of the snapshot in bytes.
+        json_binary_view(const void* data, ::std::size_t size) : nodes_(nullptr), text_(nullptr), nodeCount_(0), lastError_(JUJSON_ERROR_CODE_SUCCESS) {
+            open(data, size);
+        }
+
+        private:
+        // index of the node after the subtree of the node at index.
+        JUJSON_SIZE_TYPE end_of(JUJSON_SIZE_TYPE index) const noexcept {
+            const json_binary_node& n = nodes_[index];
+            return ((n.kind == JUSJON_JSON_VALUE_ARRAY) || (n.kind == JUSJON_JSON_VALUE_OBJECT) || (n.kind == JUSJON_JSON_VALUE_KEY)) ? static_cast<JUJSON_SIZE_TYPE>(n.extra) : index + 1;
+        }
+        // checks that the nodes form one tree and that data ranges are in the string area, in one pass over the nodes.
+        bool validate(::std::uint64_t textSize) const {
+            struct frame {
+                JUJSON_SIZE_TYPE next; // the next child
+                JUJSON_SIZE_TYPE end;
+                JUJSON_SIZE_TYPE count; // childs seen
+                JUJSON_SIZE_TYPE expected; // childs expected
+                json_value_kind kind; // JUSJON_JSON_VALUE_INVALID for the top level
+            };
+            JUJSON_DEFAULT_CONTAINER<frame> stack;
+            const frame top = {0, nodeCount_, 0, 1, JUSJON_JSON_VALUE_INVALID};
+            stack.push_back(top);
+            while (!stack.empty()) {
+                frame& parent = stack.back();
+                if (parent.next == parent.end) {
+                    if (parent.count != parent.expected)
+                        return false;
+                    stack.pop_back();
+                    continue;
+                }
+                const JUJSON_SIZE_TYPE index = parent.next;
+                const json_binary_node& n = nodes_[index];
+                if ((n.kind >= JUSJON_JSON_VALUE_INVALID) || (n.numberKind > JUJSON_NUMBER_KIND_DOUBLE))
+                    return false;
+                const json_value_kind kind = static_cast<json_value_kind>(n.kind);
+                if ((kind == JUSJON_JSON_VALUE_KEY) != (parent.kind == JUSJON_JSON_VALUE_OBJECT)) // keys in objects only, and objects hold keys only
+                    return false;
+                const bool container = (kind == JUSJON_JSON_VALUE_ARRAY) || (kind == JUSJON_JSON_VALUE_OBJECT);
+                if (!container && ((n.offset > textSize) || (n.length > textSize - n.offset)))
+                    return false;
+                JUJSON_SIZE_TYPE end = index + 1;
+                if (container || (kind == JUSJON_JSON_VALUE_KEY)) {
+                    if ((n.extra <= index) || (n.extra > parent.end))
+                        return false;
+                    end = static_cast<JUJSON_SIZE_TYPE>(n.extra);
+                }
+                ++parent.count;
+                parent.next = end;
+                if (container || (kind == JUSJON_JSON_VALUE_KEY)) {
+                    const frame child = {index + 1, end, 0, container ? n.length : 1, kind};
+                    stack.push_back(child); // parent is invalidated
+                } else if (end > parent.end) {
+                    return false;
+                }
+            }
+            return true;
+        }
+        template<class AllocatorT_>
+        json_value<StringT_, JSONTraitsT_, AllocatorT_> make_value(JUJSON_SIZE_TYPE index, const AllocatorT_& alloc) const {
+            typedef json_value<StringT_, JSONTraitsT_, AllocatorT_> json_value_type;
+            const json_binary_node& n = nodes_[index];
+            const json_value_kind kind = static_cast<json_value_kind>(n.kind);
+            if ((kind == JUSJON_JSON_VALUE_ARRAY) || (kind == JUSJON_JSON_VALUE_OBJECT)) {
+                json_value_type result(kind, alloc);
+                auto& childs = result.changed_childs();
+                childs.reserve(n.length);
+                for (JUJSON_SIZE_TYPE i = index + 1; i != static_cast<JUJSON_SIZE_TYPE>(n.extra); i = end_of(i))
+                    childs.push_back(make_value(i, alloc));
+                return result;
+            }
+            StringT_ data = string_traits<StringT_>::make(text_ + n.offset, text_ + n.offset + n.length, alloc);
+            if (kind == JUSJON_JSON_VALUE_NUMBER) {
+                json_number number;
+                number.kind = static_cast<json_number_kind>(n.numberKind);
+                number.u = n.extra;
+                return json_value_type(JUJSON_MOVE(data), number, alloc);
+            }
+            json_value_type result(JUJSON_MOVE(data), kind, alloc);
+            if (kind == JUSJON_JSON_VALUE_KEY)
+                result.add_child(make_value(index + 1, alloc));
+            return result;
+        }
+
+        public:
+        /**
+         * @brief Validates a snapshot written by encode_json_binary and views it. Nothing is copied, the snapshot must outlive the view.
+         * @param data the snapshot, aligned to 8 bytes as allocations and mapped files are. @param size the size of the snapshot in bytes.
+         * @return True if the snapshot is valid, false otherwise with JUJSON_ERROR_CODE_INVALID_BINARY.
+         */
+        bool open(const void* data, ::std::size_t size) {
+            nodes_ = nullptr;
+            text_ = nullptr;
+            nodeCount_ = 0;
+            lastError_ = JUJSON_ERROR_CODE_INVALID_BINARY;
+            const char* const bytes = static_cast<const char*>(data);
+            if ((bytes == nullptr) || (size < sizeof(json_binary_header)) || ((reinterpret_cast<::std::uintptr_t>(bytes) % alignof(json_binary_node)) != 0))
+                return false;
+            json_binary_header header;
+            ::std::memcpy(&header, bytes, sizeof(header));
+            if ((::std::memcmp(header.magic, "JUJB", 4) != 0) || (header.byteOrder != binary::byte_order) || (header.version != binary::version) || (header.charSize != sizeof(char_type)))
+                return false;
+            const ::std::uint64_t available = size - sizeof(header);
+            if ((header.nodeCount == 0) || (header.nodeCount > available / sizeof(json_binary_node)) ||
+                (header.textSize != (available - header.nodeCount * sizeof(json_binary_node)) / sizeof(char_type)) ||
+                ((available - header.nodeCount * sizeof(json_binary_node)) % sizeof(char_type) != 0))
+                return false;
+            nodes_ = reinterpret_cast<const json_binary_node*>(bytes + sizeof(header));
+            text_ = reinterpret_cast<const char_type*>(bytes + sizeof(header) + header.nodeCount * sizeof(json_binary_node));
+            nodeCount_ = static_cast<JUJSON_SIZE_TYPE>(header.nodeCount);
+            if (!validate(header.textSize)) {
+                nodes_ = nullptr;
+                text_ = nullptr;
+                nodeCount_ = 0;
+                return false;
+            }
+            lastError_ = JUJSON_ERROR_CODE_SUCCESS;
+            return true;
+        }
+        /// @brief Checks if a valid snapshot is open. @return True if a snapshot is open, false otherwise.
+        [[nodiscard]] bool is_valid() const noexcept {
+            return nodeCount_ != 0;
+        }
+        /// @brief Gets the root node. @return A cursor to the root node, invalid if no snapshot is open.
+        [[nodiscard]] cursor root() const noexcept {
+            return cursor(this, 0);
+        }
+        /**
+         * @brief Converts the snapshot to json_value.
+         * @tparam AllocatorT_ the allocator of the json_value.
+         * @param alloc the allocator to use.
+         * @return The root json_value, invalid if no snapshot is open.
+         */
+        template<class AllocatorT_ = ::std::allocator<char>>
+        [[nodiscard]] json_value<StringT_, JSONTraitsT_, AllocatorT_> to_value(const AllocatorT_& alloc = AllocatorT_()) const {
+            return root().to_value(alloc);
+        }
+        /// @brief Gets the error of the last open(). @return The last error code.
+        [[nodiscard]] error_code get_last_error() const noexcept {
+            return lastError_;
+        }
+    };
+    /**
+     * @brief Decodes a snapshot written by encode_json_binary into a json_value tree, validating it first.
+     * @tparam JSONValueT_ the json_value type to decode, with std::string_view strings refer to the snapshot.
+     * @param data the snapshot, aligned to 8 bytes. @param size the size of the snapshot in bytes.
+     * @return The decoded json_value, invalid if the snapshot is not valid.
+     */
+    template<class JSONValueT_>
+    [[nodiscard]] JSONValueT_ decode_json_binary(const void* data, ::std::size_t size, const typename JSONValueT_::allocator_type& alloc = typename JSONValueT_::allocator_type()) {
+        const json_binary_view<typename JSONValueT_::string_type, typename JSONValueT_::traits_type> view(data, size);
+        return view.to_value(alloc);
+    }
+    /**
+     * @brief Set of JSON Pointer (RFC 6901) paths compiled for matching during a parse, so that only matched values are built.
+     *        A "*" token matches every member of an object or element of an array. Paths without a leading '/' are dotted paths,
+     *        e.g. "projects.*.team.0" matches the first team member of every project. The empty path matches the whole document. At most 64 paths.
+     *        Matching runs as a handler of json_parser::parse: unmatched values are scanned and validated, never allocated.
+     * @tparam StringT_ the string type of the matched json_value objects; it must be owning for json_push_parser.
+     * @tparam JSONTraitsT_ the traits class used to define JSON-specific characteristics.
+     */
+    template<class StringT_, class JSONTraitsT_ = default_json_traits<typename StringT_::value_type>>
+    struct json_query final {
+        public:
+        typedef typename StringT_::value_type char_type;
+        typedef ::std::basic_string<char_type> path_string;
+        typedef json_value<StringT_, JSONTraitsT_> json_value_type;
+        template<class CallbackT_> struct handler;
+
+        private:
+        typedef JSONTraitsT_ json_traits;
+        typedef typename string_traits<StringT_>::owning_string_type owning_string;
+        struct segment {
+            owning_string key; // unescaped member name
+            JUJSON_SIZE_TYPE index; // array index, or no_index
+            bool wildcard;
+        };
+        static const JUJSON_SIZE_TYPE no_index = static_cast<JUJSON_SIZE_TYPE>(-1);
+        static const ::std::size_t max_paths = 64;
+
+        private:
+        JUJSON_DEFAULT_CONTAINER<JUJSON_DEFAULT_CONTAINER<segment>> paths_;
+        JUJSON_DEFAULT_CONTAINER<::std::uint64_t> completed_; // by number of segments, the paths of that length
+        bool valid_;
+
+        public:
+        /// @brief Constructs an empty json_query object.
+        json_query() : paths_(), completed_(), valid_(true) {
+
+        }
+        /// @brief Constructs a json_query object from paths, see add. @param paths the paths, reported by their position in the list.
+        json_query(::std::initializer_list<path_string> paths) : json_query() {
+            for (const auto& path : paths)
+                add(path);
+        }
+
+        private:
+        static bool push_segment(JUJSON_DEFAULT_CONTAINER<segment>& segments, owning_string&& key) {
+            segment result;
+            result.wildcard = (key.size() == 1) && (key[0] == '*');
+            result.index = no_index;
+            if (!key.empty() && ((key[0] != '0') || (key.size() == 1))) { // array index, without leading zeros
+                JUJSON_SIZE_TYPE index = 0;
+                bool digits = true;
+                for (::std::size_t i = 0; digits && (i < key.size()); ++i) {
+                    digits = (key[i] >= '0') && (key[i] <= '9') && (index <= (no_index - 10) / 10);
+                    index = index * 10 + static_cast<JUJSON_SIZE_TYPE>(key[i] - '0');
+                }
+                if (digits)
+                    result.index = index;
+            }
+            result.key = JUJSON_MOVE(key);
+            segments.push_back(JUJSON_MOVE(result));
+            return true;
+        }
+        static bool compile(const path_string& path, JUJSON_DEFAULT_CONTAINER<segment>& segments) {
+            if (path.empty())
+                return true;
+            if (path[0] != '/') { // dotted path
+                ::std::size_t b = 0;
+                for (;;) {
+                    const ::std::size_t e = path.find('.', b);
+                    const ::std::size_t end = (e == path_string::npos) ? path.size() : e;
+                    if (end == b)
+                        return false;
+                    push_segment(segments, owning_string(path.begin() + b, path.begin() + end));
+                    if (e == path_string::npos)
+                        return true;
+                    b = e + 1;
+                }
+            }
+            owning_string key;
+            for (::std::size_t i = 1; i <= path.size(); ++i) {
+                if ((i == path.size()) || (path[i] == '/')) {
+                    push_segment(segments, JUJSON_MOVE(key));
+                    key = owning_string();
+                } else if (path[i] == '~') {
+                    if ((++i == path.size()) || ((path[i] != '0') && (path[i] != '1')))
+                        return false;
+                    key.push_back((path[i] == '0') ? char_type('~') : char_type('/'));
+                } else {
+                    key.push_back(path[i]);
+                }
+            }
+            return true;
+        }
+        // the paths in active matching the key of a member as the segment at position.
+        template<class IteratorT_>
+        ::std::uint64_t match_key(::std::uint64_t active, JUJSON_SIZE_TYPE position, IteratorT_ b, IteratorT_ e) const {
+            bool escaped = false;
+            for (IteratorT_ i = b; !escaped && (i != e); ++i)
+                escaped = json_traits::is_escape_spec(*i);
+            owning_string decoded;
+            if (escaped)
+                decoded = unescape_json_string<owning_string, json_traits>(b, e);
+            const JUJSON_SIZE_TYPE size = escaped ? static_cast<JUJSON_SIZE_TYPE>(decoded.size()) : static_cast<JUJSON_SIZE_TYPE>(e - b);
+            ::std::uint64_t result = 0;
+            for (::std::size_t i = 0; i < paths_.size(); ++i) {
+                if ((active & (::std::uint64_t(1) << i)) == 0)
+                    continue;
+                const segment& s = paths_[i][position];
+                if (s.wildcard || ((static_cast<JUJSON_SIZE_TYPE>(s.key.size()) == size) &&
+                    (escaped ? (s.key == decoded) : ::std::equal(s.key.begin(), s.key.end(), b))))
+                    result |= (::std::uint64_t(1) << i);
+            }
+            return result;
+        }
+        // the paths in active matching the array element at index as the segment at position.
+        ::std::uint64_t match_index(::std::uint64_t active, JUJSON_SIZE_TYPE position, JUJSON_SIZE_TYPE index) const {
+            ::std::uint64_t result = 0;
+            for (::std::size_t i = 0; i < paths_.size(); ++i) {
+                if ((active & (::std::uint64_t(1) << i)) == 0)
+                    continue;
+                const segment& s = paths_[i][position];
+                if (s.wildcard || (s.index == index))
+                    result |= (::std::uint64_t(1) << i);
+            }
+            return result;
+        }
+        ::std::uint64_t completed(JUJSON_SIZE_TYPE segments) const noexcept {
+            return (segments < completed_.size()) ? completed_[segments] : 0;
+        }
+        ::std::uint64_t all() const noexcept {
+            return (paths_.size() == max_paths) ? ~::std::uint64_t(0) : ((::std::uint64_t(1) << paths_.size()) - 1);
+        }
+
+        public:
+        /**
+         * @brief Adds a path, matched values are reported with its position among the added paths.
+         * @param path the JSON Pointer, or dotted path.
+         * @return True if the path was added, false if it's invalid or there are already 64 paths; is_valid() is false afterwards.
+         */
+        bool add(const path_string& path) {
+            JUJSON_DEFAULT_CONTAINER<segment> segments;
+            if ((paths_.size() == max_paths) || !compile(path, segments)) {
+                valid_ = false;
+                return false;
+            }
+            if (completed_.size() <= segments.size())
+                completed_.resize(segments.size() + 1, 0);
+            completed_[segments.size()] |= (::std::uint64_t(1) << paths_.size());
+            paths_.push_back(JUJSON_MOVE(segments));
+            return true;
+        }
+        /// @brief Gets the number of paths. @return The number of added paths.
+        [[nodiscard]] ::std::size_t size() const noexcept {
+            return paths_.size();
+        }
+        /// @brief Checks if all paths were added. @return True if all paths were valid, false otherwise.
+        [[nodiscard]] bool is_valid() const noexcept {
+            return valid_;
+        }
+        /**
+         * @brief Parses one value with the parser and reports the values at the paths, in document order.
+         * @param parser the json_parser, or any parser with parse(handler), at the value to query.
+         * @param callback called as bool(std::size_t path, const json_value_type& value); returning false stops parsing with JUJSON_ERROR_CODE_ABORTED.
+         * @return The result of parser.parse: true if the whole value was valid and parsing was not stopped.
+         */
+        template<class ParserT_, class CallbackT_>
+        bool select(ParserT_& parser, CallbackT_ callback) const {
+            handler<CallbackT_> matcher(*this, callback);
+            return parser.parse(matcher);
+        }
+    };
+    /**
+     * @brief Handler of json_parser::parse matching the paths of a json_query, see json_query::select.
+     *        Matched containers are built with json_value_builder, everything else only updates the current position.
+     * @tparam CallbackT_ the callback type, called as bool(std::size_t path, const json_value_type& value).
+     */
+    template<class StringT_, class JSONTraitsT_>
+    template<class CallbackT_>
+    struct json_query<StringT_, JSONTraitsT_>::handler final {
+        private:
+        typedef json_value_builder<json_value_type> builder_type;
+        struct frame {
+            ::std::uint64_t active; // paths matched up to the container, longer than it
+            ::std::uint64_t next; // paths matched up to the value after the last key
+            JUJSON_SIZE_TYPE index; // of the next array element
+            bool object;
+        };
+        struct capture {
+            builder_type builder;
+            ::std::uint64_t matched; // paths to report the container to
+            JUJSON_SIZE_TYPE depth; // number of frames outside of the container
+        };
+
+        private:
+        const json_query& query_;
+        CallbackT_ callback_;
+        JUJSON_DEFAULT_CONTAINER<frame> frames_;
+        JUJSON_DEFAULT_CONTAINER<capture> captures_; // matched containers being built, outermost first
+
+        public:
+        /// @brief Constructs a handler object. @param query the query to match, it must outlive the handler. @param callback the callback for matched values.
+        handler(const json_query& query, CallbackT_ callback) : query_(query), callback_(callback), frames_(), captures_() {
+
+        }
+
+        private:
+        // the paths matched up to the value that begins now.
+        ::std::uint64_t begin_value() {
+            if (frames_.empty())
+                return query_.all();
+            frame& parent = frames_.back();
+            if (parent.object)
+                return parent.next;
+            const JUJSON_SIZE_TYPE index = parent.index++;
+            return (parent.active != 0) ? query_.match_index(parent.active, static_cast<JUJSON_SIZE_TYPE>(frames_.size() - 1), index) : 0;
+        }
+        bool report(::std::uint64_t matched, const json_value_type& value) {
+            for (::std::size_t i = 0; matched != 0; ++i, matched >>= 1) {
+                if (((matched & 1) != 0) && !callback_(i, value))
+                    return false;
+            }
+            return true;
+        }
+        template<class IteratorT_, class ForwardT_>
+        bool add_scalar(IteratorT_ b, IteratorT_ e, json_value_kind kind, ForwardT_ forward) {
+            for (auto& c : captures_)
+                forward(c.builder);
+            const ::std::uint64_t matched = begin_value() & query_.completed(static_cast<JUJSON_SIZE_TYPE>(frames_.size()));
+            if (matched == 0)
+                return true;
+            return report(matched, json_value_type(string_traits<StringT_>::make(b, e), kind));
+        }
+        template<class IteratorT_>
+        bool open_container(IteratorT_ b, bool object) {
+            for (auto& c : captures_)
+                object ? c.builder.on_object_begin(b) : c.builder.on_array_begin(b);
+            const ::std::uint64_t alive = begin_value();
+            const ::std::uint64_t matched = alive & query_.completed(static_cast<JUJSON_SIZE_TYPE>(frames_.size()));
+            if (matched != 0) {
+                captures_.push_back(capture{builder_type(), matched, static_cast<JUJSON_SIZE_TYPE>(frames_.size())});
+                object ? captures_.back().builder.on_object_begin(b) : captures_.back().builder.on_array_begin(b);
+            }
+            frames_.push_back(frame{alive & ~matched, 0, 0, object});
+            return true;
+        }
+        template<class IteratorT_>
+        bool close_container(IteratorT_ e, bool object) {
+            for (auto& c : captures_)
+                object ? c.builder.on_object_end(e) : c.builder.on_array_end(e);
+            frames_.pop_back();
+            if (captures_.empty() || (captures_.back().depth != frames_.size()))
+                return true;
+            const ::std::uint64_t matched = captures_.back().matched;
+            const json_value_type value = captures_.back().builder.release();
+            captures_.pop_back();
+            return report(matched, value);
+        }
+
+        public:
+        template<class IteratorT_> bool on_null(IteratorT_ b, IteratorT_ e) {
+            return add_scalar(b, e, JUSJON_JSON_VALUE_NULL, [&](builder_type& builder) { builder.on_null(b, e); });
+        }
+        template<class IteratorT_> bool on_true(IteratorT_ b, IteratorT_ e) {
+            return add_scalar(b, e, JUSJON_JSON_VALUE_TRUE, [&](builder_type& builder) { builder.on_true(b, e); });
+        }
+        template<class IteratorT_> bool on_false(IteratorT_ b, IteratorT_ e) {
+            return add_scalar(b, e, JUSJON_JSON_VALUE_FALSE, [&](builder_type& builder) { builder.on_false(b, e); });
+        }
+        template<class IteratorT_> bool on_number(IteratorT_ b, IteratorT_ e) {
+            return add_scalar(b, e, JUSJON_JSON_VALUE_NUMBER, [&](builder_type& builder) { builder.on_number(b, e); });
+        }
+        template<class IteratorT_> bool on_string(IteratorT_ b, IteratorT_ e) {
+            return add_scalar(b, e, JUSJON_JSON_VALUE_STRING, [&](builder_type& builder) { builder.on_string(b, e); });
+        }
+        template<class IteratorT_> bool on_key(IteratorT_ b, IteratorT_ e) {
+            for (auto& c : captures_)
+                c.builder.on_key(b, e);
+            frame& parent = frames_.back();
+            parent.next = (parent.active != 0) ? query_.match_key(parent.active, static_cast<JUJSON_SIZE_TYPE>(frames_.size() - 1), b, e) : 0;
+            return true;
+        }
+        template<class IteratorT_> bool on_array_begin(IteratorT_ b)              {return open_container(b, false);}
+        template<class IteratorT_> bool on_array_end(IteratorT_ e)                {return close_container(e, false);}
+        template<class IteratorT_> bool on_object_begin(IteratorT_ b)             {return open_container(b, true);}
+        template<class IteratorT_> bool on_object_end(IteratorT_ e)               {return close_container(e, true);}
+    };
+    template<class StringT_, class JSONTraitsT_> struct json_batch_parser;
+    /**
+     * @brief A robust JSON parser designed to convert JSON-formatted strings into structured json_value objects.
+     *        This class handles various JSON data types, including null, boolean(true, false), string, number, array, and object.
+     *        It provides methods to parse JSON strings, manage parsing errors, and track the current position in the input string.
+     * @tparam StringT_ the type of the string used to use.
+     * @tparam JSONTraitsT_ the traits class used to define JSON-specific characteristics.
+     * @tparam AllocatorT_ the allocator used for parsed json_value objects.
+     * @tparam PositionT_ json_lazy_position to find the line and column only when asked, json_eager_position to count them while scanning.
+     */
+    template<class StringT_, class JSONTraitsT_ = default_json_traits<typename StringT_::value_type>, class AllocatorT_ = ::std::allocator<char>, class PositionT_ = json_lazy_position>
+    struct json_parser final {
+        private:
+        typedef JSONTraitsT_ json_traits;
+        typedef PositionT_ position_policy; // true_type if line_ and column_ follow current_
+        typedef json_char_classes<json_traits> char_classes;
+        typedef json_value<StringT_, json_traits, AllocatorT_> json_value_type;
+        typedef json_tape<StringT_, json_traits> json_tape_type;
+        typedef json_compact_tree<StringT_, json_traits> json_compact_tree_type;
+#if (defined JUJSON_DEFAULT_IS_SPACE_) && (defined JUJSON_DEFAULT_IS_DIGIT_)
+        typedef ::std::integral_constant<bool, ::std::is_same<json_traits, default_json_traits<char>>::value && simd::is_contiguous_char_iterator<typename StringT_::const_iterator>::value> simd_scan; // tag for the kernels.
+#else
+        typedef ::std::false_type simd_scan;
+#endif
+
+        public:
+        typedef typename StringT_::const_iterator const_iterator;
+        typedef json_string_pool<typename StringT_::value_type, AllocatorT_> string_pool_type;
+
+        private:
+        JUJSON_SIZE_TYPE line_;
+        JUJSON_SIZE_TYPE column_;
+        const_iterator begin_;
+        const_iterator current_;
+        const_iterator end_;
+        const_iterator mark_; // with json_lazy_position, line_ and column_ are the position of mark_
+        const unsigned char* classes_; // char_classes::table()
+        error_code lastError_;
+        AllocatorT_ allocator_;
+        json_parser_options options_;
+        string_pool_type* strings_;
+
+        template<class, class> friend struct json_batch_parser; // checks what follows a record
+
+        public:
+        /// @brief Constructs a json_parser object with the specified string. @param str the string to parse. @param alloc the allocator for parsed values.
+        json_parser(const StringT_& str, const AllocatorT_& alloc = AllocatorT_()) : line_(0), column_(0), begin_(str.begin()), current_(str.begin()), end_(str.end()), mark_(str.begin()), classes_(char_classes::table()), lastError_(JUJSON_ERROR_CODE_SUCCESS), allocator_(alloc), options_(), strings_(nullptr) {
+
+        }
+        /**
+         * @brief Constructs a json_parser object with the specified iterators.
+         * @param b the beginning iterator. @param e the ending iterator. @param alloc the allocator for parsed values.
+         */
+        json_parser(const_iterator b, const_iterator e, const AllocatorT_& alloc = AllocatorT_()) : line_(0), column_(0), begin_(b), current_(b), end_(e), mark_(b), classes_(char_classes::table()), lastError_(JUJSON_ERROR_CODE_SUCCESS), allocator_(alloc), options_(), strings_(nullptr) {
+
+        }
+
+        public:
+        /**
+         * @brief Starts over on another input, as a new json_parser would, keeping the allocator, the options and the string pool.
+         * @param b the beginning iterator. @param e the ending iterator.
+         */
+        void reset(const_iterator b, const_iterator e) noexcept {
+            line_ = 0;
+            column_ = 0;
+            begin_ = b;
+            current_ = b;
+            end_ = e;
+            mark_ = b;
+            lastError_ = JUJSON_ERROR_CODE_SUCCESS;
+        }
+        /// @brief Starts over on another input, keeping the allocator, the options and the string pool. @param str the string to parse.
+        void reset(const StringT_& str) noexcept {
+            reset(str.begin(), str.end());
+        }
+
+        private:
+        unsigned char char_class(typename StringT_::value_type c) const {
+            return char_classes::get(classes_, c);
+        }
+        void next_column() { // position accounting of the scanning functions, nothing with json_lazy_position
+            if (position_policy::value)
+                ++column_;
+        }
+        void add_columns(::std::ptrdiff_t count) {
+            if (position_policy::value)
+                column_ += static_cast<JUJSON_SIZE_TYPE>(count);
+        }
+        void next_line() {
+            if (position_policy::value) {
+                column_ = 0;
+                ++line_;
+            }
+        }
+        // finds the position of current_ by counting from mark_ as the scanning functions do, mark_ must be out of string litterals.
+        void locate(JUJSON_SIZE_TYPE& line, JUJSON_SIZE_TYPE& column) const {
+            line = line_;
+            column = column_;
+            if (position_policy::value)
+                return;
+            JUJSON_SIZE_TYPE beginsCount = 0; // open string litterals
+            for (const_iterator p = mark_; p != current_; ++p) {
+                const auto val = *p;
+                if ((beginsCount != 0) && json_traits::is_escape_spec(val)) { // the escaped character is skipped without accounting
+                    ++column;
+                    if (++p == current_)
+                        break;
+                    continue;
+                }
+                if (json_traits::is_new_line(val)) {
+                    column = 0;
+                    ++line;
+                    continue;
+                }
+                ++column;
+                if (beginsCount != 0) {
+                    if (json_traits::is_string_litteral_end(val))
+                        --beginsCount;
+                    else if (json_traits::is_string_litteral_begin(val))
+                        ++beginsCount;
+                } else if (json_traits::is_string_litteral_begin(val)) {
+                    beginsCount = 1;
+                }
+            }
+        }
+        void update_position() { // line_ and column_ of current_
+            locate(line_, column_);
+            mark_ = current_;
+        }
+        bool skip_spaces() {
+            return skip_spaces(simd_scan());
+        }
+        bool skip_spaces(::std::false_type) {
+            for (; current_ != end_; ++current_) { // skip spaces
+                const unsigned char classes = char_class(*current_);
+                if ((classes & char_classes::space) == 0) {
+                    return true;
+                }
+
+                if ((classes & char_classes::new_line) != 0) {
+                    next_line();
+                } else {
+                    next_column();
+                }
+            }
+            return false;
+        }
+        bool skip_spaces(::std::true_type) {
+            if (current_ == end_)
+                return false;
+            if (!simd::is_space(*current_)) // usual case, no call
+                return true;
+            const char* const p = &*current_;
+            JUJSON_SIZE_TYPE lines = 0;
+            const char* lastNewLine = nullptr;
+            const char* const q = simd::get_kernels().skip_spaces(p, p + (end_ - current_), lines, lastNewLine);
+            if (lines == 0) {
+                add_columns(q - p);
+            } else if (position_policy::value) {
+                line_ += lines;
+                column_ = static_cast<JUJSON_SIZE_TYPE>(q - (lastNewLine + 1));
+            }
+            current_ += (q - p);
+            return current_ != end_;
+        }
+        void skip_word() {
+            for (; (current_ != end_) && ((char_class(*current_) & char_classes::alpha) != 0); ++current_) { // pass non spaces
+                next_column();
+            }
+        }
+        void skip_number() {
+            if (json_traits::is_minus(*current_)) {
+                ++current_;
+                next_column();
+            }
+            if (!skip_integer(simd_scan()))
+                return;
+            if (json_traits::is_dec_separator_symbol(*current_)) {
+                ++current_;
+                next_column();
+                if (!skip_integer(simd_scan()))
+                    return;
+            }
+            if (json_traits::is_exp_symbol(*current_)) {
+                ++current_;
+                next_column();
+                if ((current_ != end_) && (json_traits::is_minus(*current_) || (*current_ == '+'))) {
+                    ++current_;
+                    next_column();
+                }
+                skip_integer(simd_scan());
+            }
+        }
+        bool skip_integer(::std::false_type) { // returns false at the end of input
+            for (; current_ != end_; ++current_) {
+                if ((char_class(*current_) & char_classes::digit) == 0) {
+                    return true;
+                }
+                next_column();
+            }
+            return false;
+        }
+        bool skip_integer(::std::true_type) {
+            if (current_ == end_)
+                return false;
+            const char* const p = &*current_;
+            const char* const q = simd::get_kernels().skip_digits(p, p + (end_ - current_));
+            add_columns(q - p);
+            current_ += (q - p);
+            return current_ != end_;
+        }
+        bool skip_string_litteral() { // moves current_ past the string litteral end
+            if (!options_.validateEncoding)
+                return skip_string_litteral(simd_scan());
+            const const_iterator b = current_;
+            const JUJSON_SIZE_TYPE line = line_;
+            const JUJSON_SIZE_TYPE column = column_;
+            if (!skip_string_litteral(simd_scan()))
+                return false;
+            const const_iterator invalid = find_invalid_encoding(b, current_ - 1);
+            if (invalid == current_ - 1)
+                return true;
+            if (position_policy::value) { // counted again up to the invalid code unit
+                line_ = line;
+                column_ = column;
+                for (const_iterator p = b; p != invalid; ++p) {
+                    if (json_traits::is_escape_spec(*p)) {
+                        next_column();
+                        if (++p == invalid)
+                            break;
+                    } else if (json_traits::is_new_line(*p)) {
+                        next_line();
+                    } else {
+                        next_column();
+                    }
+                }
+            }
+            current_ = invalid;
+            lastError_ = JUJSON_ERROR_CODE_INVALID_ENCODING;
+            return false;
+        }
+        bool skip_string_litteral(::std::false_type) {
+            JUJSON_SIZE_TYPE beginsCount = 1;
+            for (; current_ != end_; ++current_) { // pass to string itteral end
+                const auto val = *current_;
+                if (json_traits::is_escape_spec(val)) {
+                    ++current_;
+                    next_column();
+                    if (current_ == end_)
+                        break;
+                    continue;
+                }
+                if (json_traits::is_string_litteral_end(val)) {
+                    --beginsCount;
+                    next_column();
+                } else if (json_traits::is_string_litteral_begin(val))  {
+                    ++beginsCount;
+                    next_column();
+                } else if (json_traits::is_new_line(val)) {
+                    next_line();
+                } else {
+                    next_column();
+                }
+                if (beginsCount == 0) {
+                    ++current_;
+                    return true;
+                }
+            }
+            lastError_ = JUJSON_ERROR_CODE_EOF;
+            return false;
+        }
+        bool skip_string_litteral(::std::true_type) { // same as the generic loop, as delimiters are equal nesting is impossible
+            if (current_ == end_) {
+                lastError_ = JUJSON_ERROR_CODE_EOF;
+                return false;
+            }
+            const char* const b = &*current_;
+            const char* const e = b + (end_ - current_);
+            const simd::kernels& kernels = simd::get_kernels();
+            for (const char* p = b;;) {
+                const char* const q = kernels.find_string_special(p, e);
+                add_columns(q - p);
+                p = q;
+                if (p == e)
+                    break;
+                if (*p == '\\') { // the escaped character is skipped without accounting
+                    next_column();
+                    if (e - p < 2)
+                        break;
+                    p += 2;
+                } else if (*p == '\n') {
+                    next_line();
+                    ++p;
+                } else {
+                    next_column();
+                    current_ += (p + 1 - b);
+                    return true;
+                }
+            }
+            current_ = end_;
+            lastError_ = JUJSON_ERROR_CODE_EOF;
+            return false;
+        }
+        bool aborted() {
+            lastError_ = JUJSON_ERROR_CODE_ABORTED;
+            return false;
+        }
+        // kinds of the open containers, one bit each set for objects. Nothing is allocated below 64 levels.
+        struct container_stack final {
+            ::std::uint64_t bits; // the innermost containers, the last one in the lowest bit
+            JUJSON_SIZE_TYPE size;
+            JUJSON_DEFAULT_CONTAINER<::std::uint64_t> spilled; // full words of the outer containers
+
+            container_stack() : bits(0), size(0), spilled() {
+
+            }
+            void push(bool object) {
+                if ((size != 0) && ((size & 63) == 0)) {
+                    spilled.push_back(bits);
+                    bits = 0;
+                }
+                bits = (bits << 1) | (object ? 1 : 0);
+                ++size;
+            }
+            void pop() {
+                bits >>= 1;
+                if ((--size != 0) && ((size & 63) == 0)) {
+                    bits = spilled.back();
+                    spilled.pop_back();
+                }
+            }
+            bool is_object() const {
+                return (bits & 1) != 0;
+            }
+        };
+        // begins the value at current_: a scalar is reported whole, an array or an object is opened and pushed. depth is the nesting outside of containers.
+        template<class HandlerT_>
+        bool handle_value_begin(HandlerT_& handler, container_stack& containers, JUJSON_SIZE_TYPE depth) {
+            const auto b = current_;
+            switch (char_class(*current_) & char_classes::value_mask) {
+            case char_classes::value_word: {
+                skip_word();
+                bool result = false;
+                switch (json_traits::value_kind_from_string(string_traits<StringT_>::make(b, current_))) {
+                case JUSJON_JSON_VALUE_NULL:    result = handler.on_null(b, current_); break;
+                case JUSJON_JSON_VALUE_TRUE:    result = handler.on_true(b, current_); break;
+                case JUSJON_JSON_VALUE_FALSE:   result = handler.on_false(b, current_); break;
+                default:
+                    lastError_ = JUJSON_ERROR_CODE_UNEXPECTED;
+                    return false;
+                }
+                return result || aborted();
+            }
+            case char_classes::value_string:
+                next_column();
+                ++current_;
+                if (!skip_string_litteral())
+                    return false;
+                return handler.on_string(b + 1, current_ - 1) || aborted();
+            case char_classes::value_array:
+                if (!check_depth(containers.size + depth))
+                    return false;
+                next_column();
+                ++current_;
+                containers.push(false);
+                return handler.on_array_begin(b) || aborted();
+            case char_classes::value_object:
+                if (!check_depth(containers.size + depth))
+                    return false;
+                next_column();
+                ++current_;
+                containers.push(true);
+                return handler.on_object_begin(b) || aborted();
+            case char_classes::value_number:
+                skip_number();
+                return handler.on_number(b, current_) || aborted();
+            default:
+                lastError_ = JUJSON_ERROR_CODE_UNEXPECTED;
+                return false; // unknown symbol
+            }
+        }
+        bool check_depth(JUJSON_SIZE_TYPE open) { // open containers around the one to open
+            if ((options_.maxDepth == 0) || (open < options_.maxDepth))
+                return true;
+            lastError_ = JUJSON_ERROR_CODE_DEPTH;
+            return false;
+        }
+        // parses with an explicit stack of open containers instead of recursion, nesting costs no native stack. If containers is empty current_
+        // points to the first character of the value, otherwise the innermost container was just opened and current_ is past its begin.
+        template<class HandlerT_>
+        bool handle_values(HandlerT_& handler, container_stack& containers, JUJSON_SIZE_TYPE depth) {
+            if (containers.size == 0) {
+                if (!handle_value_begin(handler, containers, depth))
+                    return false;
+                if (containers.size == 0)
+                    return true;
+            }
+            bool commaExpected = false;
+            for (;;) {
+                if (!skip_spaces())
+                    break;
+                auto val = *current_;
+                const bool object = containers.is_object();
+                if (object ? json_traits::is_object_end(val) : json_traits::is_array_end(val)) {
+                    next_column();
+                    ++current_;
+                    if (!(object ? handler.on_object_end(current_) : handler.on_array_end(current_)))
+                        return aborted();
+                    containers.pop();
+                    if (containers.size == 0)
+                        return true;
+                    commaExpected = true;
+                    continue;
+                }
+                if (commaExpected) {
+                    if (!json_traits::is_comma(val)) {
+                        lastError_ = JUJSON_ERROR_CODE_UNEXPECTED;
+                        return false;
+                    }
+                    commaExpected = false;
+                    next_column();
+                    ++current_;
+                    continue;
+                }
+                if (object) {
+                    if (!json_traits::is_string_litteral_begin(val)) {
+                        lastError_ = JUJSON_ERROR_CODE_UNEXPECTED;
+                        return false;
+                    }
+                    ++current_;
+                    next_column();
+                    const auto keyBegin = current_;
+                    if (!skip_string_litteral())
+                        return false;
+                    if (!handler.on_key(keyBegin, current_ - 1))
+                        return aborted();
+                    if (!skip_spaces())
+                        break;
+
+                    val = *current_;
+                    if (!json_traits::is_colon(val)) {
+                        lastError_ = JUJSON_ERROR_CODE_UNEXPECTED;
+                        return false;
+                    }
+                    next_column();
+                    ++current_;
+                    if (!skip_spaces())
+                        break;
+                }
+                const JUJSON_SIZE_TYPE open = containers.size;
+                if (!handle_value_begin(handler, containers, depth))
+                    return false;
+                commaExpected = (containers.size == open); // a scalar, otherwise its first element is expected
+            }
+            lastError_ = JUJSON_ERROR_CODE_EOF;
+            return false;
+        }
+        template<class HandlerT_>
+        bool handle_any_value(HandlerT_& handler, JUJSON_SIZE_TYPE depth = 0) { // current_ points to the first character of the value
+            container_stack containers;
+            return handle_values(handler, containers, depth);
+        }
+        template<class HandlerT_>
+        bool handle_json_object_expected(HandlerT_& handler) {
+            update_position();
+            for (; current_ != end_; ++current_) {
+                if (json_traits::is_object_begin(*current_)) {
+                    const auto b = current_;
+                    ++current_;
+                    mark_ = current_; // what precedes the object is not counted
+                    if (!handler.on_object_begin(b))
+                        return aborted();
+                    container_stack containers;
+                    containers.push(true);
+                    return handle_values(handler, containers, 0);
+                }
             } // no string litterals
+            mark_ = current_;
             lastError_ = JUJSON_ERROR_CODE_EOF;
-            return json_value_type();
+            return false;
+        }
+        // finds the element separators of the array at current_: its begin, commas at depth 1 and its end. line and column are set past the end.
+        bool split_json_array(JUJSON_DEFAULT_CONTAINER<const_iterator>& separators, JUJSON_SIZE_TYPE& line, JUJSON_SIZE_TYPE& column) const {
+            const_iterator lineBegin = current_;
+            JUJSON_SIZE_TYPE lineColumn = 0; // column of lineBegin
+            JUJSON_SIZE_TYPE escapes = 0; // escaped characters since lineBegin, not counted in columns
+            JUJSON_SIZE_TYPE depth = 0;
+            JUJSON_SIZE_TYPE beginsCount = 0; // open string litterals
+            locate(line, lineColumn);
+            for (const_iterator p = current_; p != end_; ++p) {
+                const auto val = *p;
+                if (json_traits::is_new_line(val)) {
+                    ++line;
+                    lineBegin = p + 1;
+                    lineColumn = 0;
+                    escapes = 0;
+                } else if (beginsCount != 0) {
+                    if (json_traits::is_escape_spec(val)) {
+                        if (++p == end_)
+                            return false;
+                        ++escapes;
+                    } else if (json_traits::is_string_litteral_end(val)) {
+                        --beginsCount;
+                    } else if (json_traits::is_string_litteral_begin(val)) {
+                        ++beginsCount;
+                    }
+                } else if (json_traits::is_string_litteral_begin(val)) {
+                    beginsCount = 1;
+                } else if (json_traits::is_array_begin(val) || json_traits::is_object_begin(val)) {
+                    if (depth++ == 0)
+                        separators.push_back(p);
+                } else if (json_traits::is_array_end(val) || json_traits::is_object_end(val)) {
+                    if (--depth == 0) {
+                        separators.push_back(p);
+                        column = lineColumn + static_cast<JUJSON_SIZE_TYPE>(p + 1 - lineBegin) - escapes;
+                        return json_traits::is_array_end(val);
+                    }
+                } else if ((depth == 1) && json_traits::is_comma(val)) {
+                    separators.push_back(p);
+                }
+            }
+            return false;
+        }
+        // parses the element between the separators into value, the element must be one value.
+        bool parse_json_array_element(const_iterator b, const_iterator e, json_value_type& value) const {
+            json_parser parser(b, e, allocator_);
+            parser.options_ = options_;
+            json_value_builder<json_value_type> builder(allocator_, options_, strings_);
+            if (!parser.skip_spaces() || !parser.handle_any_value(builder, 1) || parser.skip_spaces()) // inside of the array
+                return false;
+            value = builder.release();
+            return true;
+        }
+
+        public:
+        /**
+         * @brief Parses one JSON value of any kind from the input, reporting it to the handler instead of building json_value objects.
+         * @tparam HandlerT_ the handler type, see json_handler for the expected member functions.
+         * @param handler the handler to report the value to. Returning false from its member functions stops parsing with JUJSON_ERROR_CODE_ABORTED.
+         * @return True if the value was parsed, false otherwise.
+         */
+        template<class HandlerT_>
+        bool parse(HandlerT_& handler) {
+            if (!skip_spaces()) {
+                lastError_ = JUJSON_ERROR_CODE_EOF;
+                return false;
+            }
+            return handle_any_value(handler);
+        }
+        /**
+         * @brief Parses one JSON value of any kind from the input directly into a bound object, without building json_value objects.
+         * @param object a bool, number, string, std::vector or JUJSON_BIND struct to fill. Unknown keys are skipped, members missing in the input
+         *        or null are left as they are, arrays are replaced.
+         * @return True if the value was parsed, false otherwise. The error is JUJSON_ERROR_CODE_TYPE_MISMATCH if a value does not fit its member.
+         */
+        template<class T>
+        bool parse_into(T& object) {
+            json_bind_handler<const_iterator, json_traits> handler(object);
+            if (parse(handler))
+                return true;
+            if (handler.is_mismatch())
+                lastError_ = JUJSON_ERROR_CODE_TYPE_MISMATCH;
+            return false;
+        }
+        /**
+         * @brief Parses a JSON object from the input, reporting it to the handler instead of building json_value objects.
+         * @tparam HandlerT_ the handler type, see json_handler for the expected member functions.
+         * @param handler the handler to report the object to. Returning false from its member functions stops parsing with JUJSON_ERROR_CODE_ABORTED.
+         * @return True if the object was parsed, false otherwise.
+         */
+        template<class HandlerT_>
+        bool parse_json_object_expected(HandlerT_& handler) {
+            return handle_json_object_expected(handler);
+        }
+        /// @brief Parses a JSON object from the input. @return The parsed json_value object.
+        [[nodiscard]] json_value_type parse_json_object_expected() {
+            json_value_builder<json_value_type> builder(allocator_, options_, strings_);
+            if (!handle_json_object_expected(builder))
+                return json_value_type();
+            return builder.release();
+        }
+        /**
+         * @brief Parses a JSON object from the input into a flat json_tape, without copying strings. The input must outlive the tape.
+         * @return The parsed json_tape, empty on error. A string or a container text longer than 4G code units fails with JUJSON_ERROR_CODE_ABORTED.
+         */
+        [[nodiscard]] json_tape_type parse_json_tape_expected() {
+            json_tape_type tape(begin_);
+            json_tape_builder<json_tape_type> builder(tape);
+            if (!handle_json_object_expected(builder))
+                tape.clear();
+            return tape;
+        }
+        /**
+         * @brief Parses a JSON object from the input into a json_compact_tree of 16-byte nodes. Strings are copied, the input can be released.
+         * @return The parsed json_compact_tree, empty on error. A string longer than 4G code units or a container of more than 4G childs fails with JUJSON_ERROR_CODE_ABORTED.
+         */
+        [[nodiscard]] json_compact_tree_type parse_json_compact_expected() {
+            json_compact_tree_type tree;
+            json_compact_builder<json_compact_tree_type> builder(tree);
+            if (!handle_json_object_expected(builder))
+                tree.clear();
+            return tree;
+        }
+        /**
+         * @brief Parses one JSON value of any kind from the input. A top-level array is split at its commas by a scan of the structure
+         *        and its elements are parsed concurrently. The result, the error and the position are the same as those of sequential parsing:
+         *        invalid input is parsed again sequentially to report the error. Parsed values are allocated from several threads.
+         *        With a string pool the array is parsed sequentially, the pool is not shared between threads.
+         * @param threads the number of threads to use, all hardware threads if 0.
+         * @return The parsed json_value object, invalid on error.
+         */
+        [[nodiscard]] json_value_type parse_json_array_parallel(unsigned threads = 0) {
+            update_position();
+            const const_iterator start = current_;
+            const JUJSON_SIZE_TYPE startLine = line_;
+            const JUJSON_SIZE_TYPE startColumn = column_;
+            JUJSON_DEFAULT_CONTAINER<const_iterator> separators;
+            JUJSON_SIZE_TYPE line = 0;
+            JUJSON_SIZE_TYPE column = 0;
+            if ((strings_ == nullptr) && skip_spaces() && json_traits::is_array_begin(*current_) && split_json_array(separators, line, column)) {
+                ::std::size_t count = separators.size() - 1;
+                bool blank = true; // the last element may be empty after a trailing comma, or for an empty array
+                for (const_iterator p = separators[count - 1] + 1; blank && (p != separators[count]); ++p)
+                    blank = char_classes::is_space(*p);
+                if (blank && ((count == 1) || json_traits::is_comma(*separators[count - 1])))
+                    --count;
+                const ::std::size_t blockSize = (::std::max)(static_cast<::std::size_t>(1), (::std::min)(static_cast<::std::size_t>(64), count / (parallel::thread_count(threads) * 16)));
+                const ::std::size_t blocks = (count + blockSize - 1) / blockSize;
+                JUJSON_DEFAULT_CONTAINER<json_value_type> elements(count);
+                JUJSON_DEFAULT_CONTAINER<char> parsed(blocks, 1);
+                parallel::for_each_block(blocks, threads, [&](::std::size_t block) {
+                    const ::std::size_t last = (::std::min)(count, (block + 1) * blockSize);
+                    for (::std::size_t i = block * blockSize; (i < last) && parsed[block]; ++i)
+                        parsed[block] = parse_json_array_element(separators[i] + 1, separators[i + 1], elements[i]);
+                });
+                if (::std::find(parsed.begin(), parsed.end(), 0) == parsed.end()) {
+                    json_value_type result(JUSJON_JSON_VALUE_ARRAY, allocator_);
+                    result.changed_childs().reserve(count);
+                    for (auto& element : elements)
+                        result.add_child(JUJSON_MOVE(element));
+                    current_ = separators.back() + 1;
+                    line_ = line;
+                    column_ = column;
+                    mark_ = current_;
+                    return result;
+                }
+            }
+            current_ = start; // not an array or invalid, the sequential parser finds the error
+            line_ = startLine;
+            column_ = startColumn;
+            mark_ = start;
+            json_value_builder<json_value_type> builder(allocator_, options_, strings_);
+            if (!parse(builder))
+                return json_value_type();
+            return builder.release();
+        }
+        /// @brief Sets the options for parsed json_value trees. @param options the options.
+        void set_options(const json_parser_options& options) {
+            options_ = options;
+        }
+        /// @brief Gets the options for parsed json_value trees. @return The options.
+        [[nodiscard]] const json_parser_options& get_options() const noexcept {
+            return options_;
+        }
+        /**
+         * @brief Sets the pool that keys of parsed json_value trees are interned in, with short strings up to json_parser_options::internLength.
+         *        Other strings and the text of lazy containers are copied into the pool, so with std::string_view the values refer to the pool
+         *        instead of the input, and the pool must outlive them. Owning strings are made from the pool for interned strings only.
+         * @param strings the pool, nullptr to make strings from the input.
+         */
+        void set_string_pool(string_pool_type* strings) noexcept {
+            strings_ = strings;
+        }
+        /// @brief Gets the pool that strings of parsed json_value trees are made from. @return The pool, nullptr if none.
+        [[nodiscard]] string_pool_type* get_string_pool() const noexcept {
+            return strings_;
+        }
+        /// @brief Gets the current column position in the input, counted from the last known position with json_lazy_position. @return The current column position.
+        [[nodiscard]] JUJSON_SIZE_TYPE column() const {
+            JUJSON_SIZE_TYPE line = 0;
+            JUJSON_SIZE_TYPE column = 0;
+            locate(line, column);
+            return column;
+        }
+        /// @brief Gets the current line position in the input, counted from the last known position with json_lazy_position. @return The current line position.
+        [[nodiscard]] JUJSON_SIZE_TYPE line() const {
+            JUJSON_SIZE_TYPE line = 0;
+            JUJSON_SIZE_TYPE column = 0;
+            locate(line, column);
+            return line;
+        }
+        /// @brief Gets the last error code encountered during parsing. @return The last error code.
+        [[nodiscard]] error_code get_last_error() const {
+            return lastError_;
+        }
+    };
+    enum push_status {
+        JUJSON_PUSH_STATUS_NEED_MORE, // the value is not complete yet, feed more input.
+        JUJSON_PUSH_STATUS_COMPLETE,
+        JUJSON_PUSH_STATUS_ERROR,
+    };
+    /**
+     * @brief Incremental JSON parser, input is fed in chunks split at arbitrary positions, even inside of strings, numbers and escape sequences.
+     *        Parses one value of any kind and reports it to the handler like json_parser::parse. Tokens that fit in one chunk are given
+     *        as ranges of the chunk, others are collected in an internal buffer; in both cases ranges are valid only during the call.
+     *        Position tracking continues across chunks, line() and column() match what json_parser reports for the whole input.
+     * @tparam StringT_ the type of the string to use, its value_type is the input character type.
+     * @tparam JSONTraitsT_ the traits class used to define JSON-specific characteristics.
+     * @tparam HandlerT_ the handler to report values to, builds json_value by default. Its string type must be owning.
+     */
+    template<class StringT_, class JSONTraitsT_ = default_json_traits<typename StringT_::value_type>, class HandlerT_ = json_value_builder<json_value<StringT_, JSONTraitsT_>>>
+    struct json_push_parser final {
+        public:
+        typedef typename StringT_::value_type char_type;
+        typedef const char_type* const_iterator;
+
+        private:
+        typedef JSONTraitsT_ json_traits;
+        typedef json_char_classes<json_traits> char_classes;
+        enum parse_state {
+            state_value,        // value expected
+            state_array_value,  // value or array end expected
+            state_key,          // key or object end expected
+            state_colon,
+            state_after_value,  // comma or container end expected
+            state_string,
+            state_number,
+            state_word,
+            state_done,
+            state_error,
+        };
+#if (defined JUJSON_DEFAULT_IS_SPACE_) && (defined JUJSON_DEFAULT_IS_DIGIT_)
+        typedef ::std::integral_constant<bool, ::std::is_same<json_traits, default_json_traits<char>>::value> simd_scan; // tag for the kernels.
+#else
+        typedef ::std::false_type simd_scan;
+#endif
+
+        private:
+        HandlerT_ handler_;
+        JUJSON_DEFAULT_CONTAINER<json_value_kind> stack_; // open arrays and objects
+        ::std::basic_string<char_type> token_; // parts of the current token from previous chunks
+        parse_state state_;
+        bool key_; // the current string is a key
+        bool escape_; // the previous character was the escape one
+        int numberPart_; // 0 - integer, 1 - fraction, 2 - exponent sign, 3 - exponent
+        JUJSON_SIZE_TYPE beginsCount_;
+        JUJSON_SIZE_TYPE line_;
+        JUJSON_SIZE_TYPE column_;
+        JUJSON_SIZE_TYPE maxDepth_; // json_parser_options::maxDepth
+        error_code lastError_;
+        const unsigned char* classes_; // char_classes::table()
+
+        public:
+        /**
+         * @brief Constructs a json_push_parser object.
+         * @param handler the handler to report values to, copied.
+         * @param options only maxDepth is used, deeper nesting fails with JUJSON_ERROR_CODE_DEPTH; the handler has its own options.
+         */
+        explicit json_push_parser(const HandlerT_& handler = HandlerT_(), const json_parser_options& options = json_parser_options()) : handler_(handler), stack_(), token_(),
+            state_(state_value), key_(false), escape_(false), numberPart_(0), beginsCount_(0), line_(0), column_(0), maxDepth_(options.maxDepth),
+            lastError_(JUJSON_ERROR_CODE_SUCCESS), classes_(char_classes::table()) {
+
         }
-        json_value_type parse_json_object() {
-            json_value_type objectResult(JUSJON_JSON_VALUE_OBJECT);
-            bool commaExpected = false;
+
+        private:
+        unsigned char char_class(char_type c) const {
+            return char_classes::get(classes_, c);
+        }
+        push_status fail(error_code code) {
+            lastError_ = code;
+            state_ = state_error;
+            return JUJSON_PUSH_STATUS_ERROR;
+        }
+        void end_value() {
+            state_ = stack_.empty() ? state_done : state_after_value;
+        }
+        // calls emit with the token, [b, e) is its part from the current chunk.
+        template<class EmitT_>
+        bool end_token(const_iterator b, const_iterator e, EmitT_ emit) {
+            if (token_.empty())
+                return emit(b, e);
+            token_.append(b, e);
+            const bool result = emit(token_.data(), token_.data() + token_.size());
+            token_.clear();
+            return result;
+        }
+        bool emit_string(const_iterator b, const_iterator e) {
+            return key_ ? handler_.on_key(b, e) : handler_.on_string(b, e);
+        }
+        bool emit_number(const_iterator b, const_iterator e) {
+            return handler_.on_number(b, e);
+        }
+        bool emit_word(const_iterator b, const_iterator e) {
+            switch (json_traits::value_kind_from_string(string_traits<StringT_>::make(b, e))) {
+            case JUSJON_JSON_VALUE_NULL:    return handler_.on_null(b, e) || (lastError_ = JUJSON_ERROR_CODE_ABORTED, false);
+            case JUSJON_JSON_VALUE_TRUE:    return handler_.on_true(b, e) || (lastError_ = JUJSON_ERROR_CODE_ABORTED, false);
+            case JUSJON_JSON_VALUE_FALSE:   return handler_.on_false(b, e) || (lastError_ = JUJSON_ERROR_CODE_ABORTED, false);
+            default:
+                lastError_ = JUJSON_ERROR_CODE_UNEXPECTED;
+                return false;
+            }
+        }
+        // scans string litteral content, stops at its end delimiter.
+        const_iterator scan_string(const_iterator p, const_iterator e, ::std::false_type) {
+            for (; p != e; ++p) {
+                const char_type val = *p;
+                if (escape_) { // the escaped character is skipped without accounting
+                    escape_ = false;
+                    continue;
+                }
+                if (json_traits::is_escape_spec(val)) {
+                    escape_ = true;
+                    ++column_;
+                } else if (json_traits::is_string_litteral_end(val)) {
+                    ++column_;
+                    if (--beginsCount_ == 0)
+                        return p;
+                } else if (json_traits::is_string_litteral_begin(val)) {
+                    ++beginsCount_;
+                    ++column_;
+                } else if (json_traits::is_new_line(val)) {
+                    column_ = 0;
+                    ++line_;
+                } else {
+                    ++column_;
+                }
+            }
+            return e;
+        }
+        const_iterator scan_string(const_iterator p, const_iterator e, ::std::true_type) {
+            const simd::kernels& kernels = simd::get_kernels();
             for (;;) {
-                if (!skip_spaces())
-                    break;
-                auto val = *current_;
-                if (json_traits::is_object_end(val)) {
+                if ((p != e) && escape_) {
+                    escape_ = false;
+                    ++p;
+                }
+                const_iterator q = kernels.find_string_special(p, e);
+                column_ += static_cast<JUJSON_SIZE_TYPE>(q - p);
+                p = q;
+                if (p == e)
+                    return e;
+                if (*p == '\"') {
                     ++column_;
-                    ++current_;
-                    return objectResult;
+                    return p;
+                } else if (*p == '\\') {
+                    escape_ = true;
+                    ++column_;
+                } else {
+                    column_ = 0;
+                    ++line_;
                 }
-                if (commaExpected) { 
-                    if (!json_traits::is_comma(val)) {
-                        lastError_ = JUJSON_ERROR_CODE_UNEXPECTED;
-                        return json_value_type();
-                    }
-                    commaExpected = false;
+                ++p;
+            }
+        }
+        // scans number characters, returns the first character after the number, or e.
+        const_iterator scan_number(const_iterator p, const_iterator e) {
+            for (; p != e; ++p) {
+                const char_type val = *p;
+                if ((char_class(val) & char_classes::digit) != 0) {
+                    numberPart_ = (numberPart_ == 2) ? 3 : numberPart_;
                     ++column_;
-                    ++current_;
+                } else if ((numberPart_ == 0) && json_traits::is_dec_separator_symbol(val)) {
+                    numberPart_ = 1;
+                    ++column_;
+                } else if ((numberPart_ < 2) && json_traits::is_exp_symbol(val)) {
+                    numberPart_ = 2;
+                    ++column_;
+                } else if ((numberPart_ == 2) && (json_traits::is_minus(val) || (val == '+'))) {
+                    numberPart_ = 3;
+                    ++column_;
+                } else {
+                    return p;
+                }
+            }
+            return e;
+        }
+        bool open_container(const_iterator p) {
+            const char_type val = *p;
+            if ((maxDepth_ != 0) && (static_cast<JUJSON_SIZE_TYPE>(stack_.size()) >= maxDepth_)) {
+                lastError_ = JUJSON_ERROR_CODE_DEPTH;
+                return false;
+            }
+            ++column_;
+            if (json_traits::is_array_begin(val)) {
+                stack_.push_back(JUSJON_JSON_VALUE_ARRAY);
+                state_ = state_array_value;
+                return handler_.on_array_begin(p) || (lastError_ = JUJSON_ERROR_CODE_ABORTED, false);
+            }
+            stack_.push_back(JUSJON_JSON_VALUE_OBJECT);
+            state_ = state_key;
+            return handler_.on_object_begin(p) || (lastError_ = JUJSON_ERROR_CODE_ABORTED, false);
+        }
+        bool close_container(const_iterator e) { // e points past the container end
+            const json_value_kind kind = stack_.back();
+            stack_.pop_back();
+            end_value();
+            return (kind == JUSJON_JSON_VALUE_ARRAY) ? handler_.on_array_end(e) : handler_.on_object_end(e);
+        }
+
+        public:
+        /**
+         * @brief Parses the next chunk of the input.
+         * @param data the chunk. @param size the size of the chunk.
+         * @return JUJSON_PUSH_STATUS_COMPLETE if the value is complete, JUJSON_PUSH_STATUS_NEED_MORE if more input is needed
+         *         (numbers and words at top level are complete only after finish()), JUJSON_PUSH_STATUS_ERROR on error.
+         */
+        push_status feed(const char_type* data, JUJSON_SIZE_TYPE size) {
+            if (state_ == state_error)
+                return JUJSON_PUSH_STATUS_ERROR;
+            const_iterator p = data;
+            const_iterator const e = data + size;
+            const_iterator tokenBegin = data; // beginning of the token part in this chunk
+            while (p != e) {
+                const char_type val = *p;
+                switch (state_) {
+                case state_string: {
+                    p = scan_string(p, e, simd_scan());
+                    if (p == e)
+                        break;
+                    if (!end_token(tokenBegin, p, [this](const_iterator tb, const_iterator te) { return emit_string(tb, te); }))
+                        return fail(JUJSON_ERROR_CODE_ABORTED);
+                    ++p;
+                    if (key_)
+                        state_ = state_colon;
+                    else
+                        end_value();
                     continue;
                 }
-                json_value_type keyChild(parse_string_litteral_expected(), JUSJON_JSON_VALUE_KEY);
-                if (keyChild.data().empty())
-                    return json_value_type();
-                if (!skip_spaces())
+                case state_number: {
+                    p = scan_number(p, e);
+                    if (p == e)
+                        break;
+                    if (!end_token(tokenBegin, p, [this](const_iterator tb, const_iterator te) { return emit_number(tb, te); }))
+                        return fail(JUJSON_ERROR_CODE_ABORTED);
+                    end_value();
+                    continue;
+                }
+                case state_word: {
+                    for (; (p != e) && ((char_class(*p) & char_classes::alpha) != 0); ++p)
+                        ++column_;
+                    if (p == e)
+                        break;
+                    if (!end_token(tokenBegin, p, [this](const_iterator tb, const_iterator te) { return emit_word(tb, te); }))
+                        return fail(lastError_);
+                    end_value();
+                    continue;
+                }
+                case state_error:
+                    return JUJSON_PUSH_STATUS_ERROR;
+                default:
                     break;
-
-                val = *current_;
-                if (!json_traits::is_colon(val)) {
-                    lastError_ = JUJSON_ERROR_CODE_UNEXPECTED;
-                    return json_value_type();
                 }
-                ++column_;
-                ++current_;
-                if (!skip_spaces())
+                if (p == e)
                     break;
-                json_value_type valueChild = parse_any_value();
-                if (!valueChild.is_valid())
-                    return json_value_type();
-                keyChild.add_child(valueChild);
-                objectResult.add_child(JUJSON_MOVE(keyChild));
-                commaExpected = true;
+
+                const unsigned char classes = char_class(val);
+                if ((classes & char_classes::space) != 0) {
+                    if ((classes & char_classes::new_line) != 0) {
+                        column_ = 0;
+                        ++line_;
+                    } else {
+                        ++column_;
+                    }
+                    ++p;
+                    continue;
+                }
+                switch (state_) {
+                case state_array_value:
+                    if (json_traits::is_array_end(val)) {
+                        ++column_;
+                        ++p;
+                        if (!close_container(p))
+                            return fail(JUJSON_ERROR_CODE_ABORTED);
+                        continue;
+                    }
+                    // fall through
+                case state_value:
+                    switch (classes & char_classes::value_mask) {
+                    case char_classes::value_word:
+                        tokenBegin = p;
+                        state_ = state_word;
+                        break;
+                    case char_classes::value_string:
+                        ++column_;
+                        ++p;
+                        tokenBegin = p;
+                        key_ = false;
+                        beginsCount_ = 1;
+                        state_ = state_string;
+                        break;
+                    case char_classes::value_array:
+                    case char_classes::value_object:
+                        if (!open_container(p))
+                            return fail(lastError_);
+                        ++p;
+                        break;
+                    case char_classes::value_number:
+                        tokenBegin = p;
+                        numberPart_ = 0;
+                        state_ = state_number;
+                        if (json_traits::is_minus(val)) {
+                            ++column_;
+                            ++p;
+                        }
+                        break;
+                    default:
+                        return fail(JUJSON_ERROR_CODE_UNEXPECTED); // unknown symbol
+                    }
+                    continue;
+                case state_key:
+                    if (json_traits::is_object_end(val)) {
+                        ++column_;
+                        ++p;
+                        if (!close_container(p))
+                            return fail(JUJSON_ERROR_CODE_ABORTED);
+                    } else if (json_traits::is_string_litteral_begin(val)) {
+                        ++column_;
+                        ++p;
+                        tokenBegin = p;
+                        key_ = true;
+                        beginsCount_ = 1;
+                        state_ = state_string;
+                    } else {
+                        return fail(JUJSON_ERROR_CODE_UNEXPECTED);
+                    }
+                    continue;
+                case state_colon:
+                    if (!json_traits::is_colon(val))
+                        return fail(JUJSON_ERROR_CODE_UNEXPECTED);
+                    ++column_;
+                    ++p;
+                    state_ = state_value;
+                    continue;
+                case state_after_value:
+                    if ((stack_.back() == JUSJON_JSON_VALUE_ARRAY) ? json_traits::is_array_end(val) : json_traits::is_object_end(val)) {
+                        ++column_;
+                        ++p;
+                        if (!close_container(p))
+                            return fail(JUJSON_ERROR_CODE_ABORTED);
+                    } else if (json_traits::is_comma(val)) {
+                        ++column_;
+                        ++p;
+                        state_ = (stack_.back() == JUSJON_JSON_VALUE_ARRAY) ? state_array_value : state_key;
+                    } else {
+                        return fail(JUJSON_ERROR_CODE_UNEXPECTED);
+                    }
+                    continue;
+                default: // state_done, only spaces may follow the value
+                    return fail(JUJSON_ERROR_CODE_UNEXPECTED);
+                }
             }
-            lastError_ = JUJSON_ERROR_CODE_EOF;
-            return json_value_type();
+            if ((state_ == state_string) || (state_ == state_number) || (state_ == state_word))
+                token_.append(tokenBegin, e);
+            return (state_ == state_done) ? JUJSON_PUSH_STATUS_COMPLETE : JUJSON_PUSH_STATUS_NEED_MORE;
+        }
+        /// @brief Parses the next chunk of the input. @param str the chunk. @return Same as feed(const char_type*, JUJSON_SIZE_TYPE).
+        push_status feed(const StringT_& str) {
+            return feed(str.data(), static_cast<JUJSON_SIZE_TYPE>(str.size()));
+        }
+        /**
+         * @brief Tells the parser the input is over, completing a number or a word at its end.
+         * @return JUJSON_PUSH_STATUS_COMPLETE if the value is complete, JUJSON_PUSH_STATUS_ERROR otherwise (JUJSON_ERROR_CODE_EOF for incomplete value).
+         */
+        push_status finish() {
+            if (state_ == state_error)
+                return JUJSON_PUSH_STATUS_ERROR;
+            if ((state_ == state_number) || (state_ == state_word)) {
+                const bool emitted = (state_ == state_number) ?
+                    (emit_number(token_.data(), token_.data() + token_.size()) || (lastError_ = JUJSON_ERROR_CODE_ABORTED, false)) :
+                    emit_word(token_.data(), token_.data() + token_.size());
+                token_.clear();
+                if (!emitted)
+                    return fail(lastError_);
+                end_value();
+            }
+            if (state_ != state_done)
+                return fail(JUJSON_ERROR_CODE_EOF);
+            return JUJSON_PUSH_STATUS_COMPLETE;
+        }
+        /// @brief Makes the parser ready for a new value, keeping the handler and buffers. A handler with release() drops what it built so far.
+        void reset() {
+            drop_handler_value(handler_, 0);
+            stack_.clear();
+            token_.clear();
+            state_ = state_value;
+            escape_ = false;
+            line_ = 0;
+            column_ = 0;
+            lastError_ = JUJSON_ERROR_CODE_SUCCESS;
+        }
+        private:
+        template<class H_>
+        static auto drop_handler_value(H_& handler, int) -> decltype(static_cast<void>(handler.release())) {
+            static_cast<void>(handler.release());
+        }
+        template<class H_>
+        static void drop_handler_value(H_&, long) { // nothing to drop
         }
-        json_value_type parse_any_value() {
-            const auto val = *current_;
-            if (JUJSON_IS_ALPHA(val)) {
-                json_value_type wordChild = parse_word_json();
-                if (!wordChild.is_valid())
-                    return json_value_type();
-                return wordChild;
-            } else if (json_traits::is_string_litteral_begin(val)) {
-                ++column_;
-                ++current_;
 
-                StringT_ data = parse_string_litteral();
-                if (data.empty())
-                    return json_value_type();
-                return json_value_type(JUJSON_MOVE(data), JUSJON_JSON_VALUE_STRING);
-            } else if (json_traits::is_array_begin(val)) {
-                ++column_;
-                ++current_;
+        public:
+        /// @brief Gets the handler. @return A reference to the handler.
+        [[nodiscard]] HandlerT_& handler() noexcept {
+            return handler_;
+        }
+        /// @brief Takes the value built by the default handler. @return The parsed json_value object, invalid if nothing was built.
+        template<class H_ = HandlerT_>
+        [[nodiscard]] auto release() -> decltype(::std::declval<H_&>().release()) {
+            return handler_.release();
+        }
+        /// @brief Gets the current column position in the input. @return The current column position.
+        [[nodiscard]] JUJSON_SIZE_TYPE column() const {
+            return column_;
+        }
+        /// @brief Gets the current line position in the input. @return The current line position.
+        [[nodiscard]] JUJSON_SIZE_TYPE line() const {
+            return line_;
+        }
+        /// @brief Gets the last error code encountered during parsing. @return The last error code.
+        [[nodiscard]] error_code get_last_error() const {
+            return lastError_;
+        }
+    };
+    enum json_batch_format {
+        JUJSON_BATCH_FORMAT_NDJSON,         // one value per line, blank lines are skipped.
+        JUJSON_BATCH_FORMAT_CONCATENATED,   // values follow each other, separated by optional spaces.
+    };
+    /**
+     * @brief The result of parsing one record of a batch.
+     * @tparam JSONValueT_ the json_value type of the record.
+     */
+    template<class JSONValueT_>
+    struct json_batch_record {
+        JSONValueT_ value;          // invalid on error
+        error_code error;
+        JUJSON_SIZE_TYPE offset;    // offset of the record in the input
+        JUJSON_SIZE_TYPE line;      // line in the whole input, of the error or of the record beginning
+        JUJSON_SIZE_TYPE column;
+    };
+    /**
+     * @brief Parses a buffer of many JSON documents, newline-delimited or concatenated, on all cores.
+     *        The buffer is split into records with a scan of the structure, then the records are parsed
+     *        by worker threads that take the next block of records as they finish the previous one.
+     *        Results are in input order; errors do not stop parsing of the other records.
+     * @tparam StringT_ the type of the string to use.
+     * @tparam JSONTraitsT_ the traits class used to define JSON-specific characteristics.
+     */
+    template<class StringT_, class JSONTraitsT_ = default_json_traits<typename StringT_::value_type>>
+    struct json_batch_parser final {
+        public:
+        typedef typename StringT_::const_iterator const_iterator;
+        typedef json_value<StringT_, JSONTraitsT_> json_value_type;
+        typedef json_batch_record<json_value_type> record_type;
+        typedef JUJSON_DEFAULT_CONTAINER<record_type> container_type;
 
-                json_value_type arrayChild = parse_json_array();
-                if (!arrayChild.is_valid())
-                    return json_value_type();
-                return arrayChild;
-            } else if (json_traits::is_object_begin(val)) {
-                ++column_;
-                ++current_;
+        private:
+        typedef JSONTraitsT_ json_traits;
+        typedef typename StringT_::value_type char_type;
+#if (defined JUJSON_DEFAULT_IS_SPACE_) && (defined JUJSON_DEFAULT_IS_DIGIT_)
+        typedef ::std::integral_constant<bool, ::std::is_same<json_traits, default_json_traits<char>>::value && simd::is_contiguous_char_iterator<const_iterator>::value> simd_scan; // memchr for lines.
+#else
+        typedef ::std::false_type simd_scan;
+#endif
+        struct record_range {
+            const_iterator begin;
+            const_iterator end;
+            JUJSON_SIZE_TYPE line;
+            JUJSON_SIZE_TYPE column;
+        };
+        static constexpr JUJSON_SIZE_TYPE blockSize = 64; // records taken by a worker at once
 
-                json_value_type objChild = parse_json_object();
-                if (!objChild.is_valid())
-                    return json_value_type();
-                return objChild;
-            } else if (JUJSON_IS_DIGIT(val) || json_traits::is_minus(val)) {
-                json_value_type numberChild = parse_number_json();
-                if (!numberChild.is_valid())
-                    return json_value_type();
-                return numberChild;
+        private:
+        const_iterator begin_;
+        const_iterator end_;
+        json_batch_format format_;
+
+        public:
+        /// @brief Constructs a json_batch_parser object with the specified string. @param str the documents to parse. @param format how documents are separated.
+        json_batch_parser(const StringT_& str, json_batch_format format = JUJSON_BATCH_FORMAT_NDJSON) : begin_(str.begin()), end_(str.end()), format_(format) {
+
+        }
+        /**
+         * @brief Constructs a json_batch_parser object with the specified iterators.
+         * @param b the beginning iterator. @param e the ending iterator. @param format how documents are separated.
+         */
+        json_batch_parser(const_iterator b, const_iterator e, json_batch_format format = JUJSON_BATCH_FORMAT_NDJSON) : begin_(b), end_(e), format_(format) {
+
+        }
+
+        private:
+        const_iterator find_new_line(const_iterator p, ::std::false_type) const {
+            for (; p != end_; ++p) {
+                if (json_traits::is_new_line(*p))
+                    return p;
+            }
+            return end_;
+        }
+        const_iterator find_new_line(const_iterator p, ::std::true_type) const {
+            if (p == end_)
+                return end_;
+            const void* found = ::std::memchr(&*p, '\n', static_cast<::std::size_t>(end_ - p));
+            return (found == nullptr) ? end_ : p + (static_cast<const char*>(found) - &*p);
+        }
+        // moves p past the value starting at it: a container with its content or a word up to a space.
+        const_iterator skip_record(const_iterator p, JUJSON_SIZE_TYPE& line, const_iterator& lineBegin) const {
+            const const_iterator b = p;
+            JUJSON_SIZE_TYPE depth = 0;
+            JUJSON_SIZE_TYPE beginsCount = 0; // open string litterals
+            for (; p != end_; ++p) {
+                const char_type val = *p;
+                if (beginsCount != 0) {
+                    if (json_traits::is_escape_spec(val)) {
+                        if (++p == end_)
+                            break;
+                    } else if (json_traits::is_string_litteral_end(val)) {
+                        if ((--beginsCount == 0) && (depth == 0))
+                            return p + 1;
+                    } else if (json_traits::is_string_litteral_begin(val)) {
+                        ++beginsCount;
+                    } else if (json_traits::is_new_line(val)) {
+                        ++line;
+                        lineBegin = p + 1;
+                    }
+                } else if (json_traits::is_string_litteral_begin(val)) {
+                    beginsCount = 1;
+                } else if (json_traits::is_array_begin(val) || json_traits::is_object_begin(val)) {
+                    ++depth;
+                } else if (json_traits::is_array_end(val) || json_traits::is_object_end(val)) {
+                    if (depth == 0) // unbalanced, the parser reports it
+                        return (p == b) ? p + 1 : p;
+                    if (--depth == 0)
+                        return p + 1;
+                } else if (json_char_classes<json_traits>::is_space(val)) {
+                    if (depth == 0)
+                        return p;
+                    if (json_traits::is_new_line(val)) {
+                        ++line;
+                        lineBegin = p + 1;
+                    }
+                }
+            }
+            return end_;
+        }
+        bool is_blank(const_iterator b, const_iterator e) const {
+            for (; b != e; ++b) {
+                if (!json_char_classes<json_traits>::is_space(*b))
+                    return false;
+            }
+            return true;
+        }
+        JUJSON_DEFAULT_CONTAINER<record_range> split() const {
+            JUJSON_DEFAULT_CONTAINER<record_range> result;
+            JUJSON_SIZE_TYPE line = 0;
+            const_iterator p = begin_;
+            if (format_ == JUJSON_BATCH_FORMAT_NDJSON) {
+                while (p != end_) {
+                    const const_iterator e = find_new_line(p, simd_scan());
+                    if (!is_blank(p, e))
+                        result.push_back(record_range{p, e, line, 0});
+                    if (e == end_)
+                        break;
+                    p = e + 1;
+                    ++line;
+                }
+                return result;
+            }
+            const_iterator lineBegin = begin_;
+            for (;;) {
+                for (; (p != end_) && json_char_classes<json_traits>::is_space(*p); ++p) {
+                    if (json_traits::is_new_line(*p)) {
+                        ++line;
+                        lineBegin = p + 1;
+                    }
+                }
+                if (p == end_)
+                    return result;
+                const record_range range{p, p, line, static_cast<JUJSON_SIZE_TYPE>(p - lineBegin)};
+                result.push_back(range);
+                p = skip_record(p, line, lineBegin);
+                result.back().end = p;
+            }
+        }
+        void parse_record(const record_range& range, record_type& result) const {
+            json_parser<StringT_, json_traits> parser(range.begin, range.end);
+            json_value_builder<json_value_type> builder;
+            result.offset = static_cast<JUJSON_SIZE_TYPE>(range.begin - begin_);
+            result.error = JUJSON_ERROR_CODE_SUCCESS;
+            if (!parser.parse(builder))
+                result.error = parser.get_last_error();
+            else if (parser.skip_spaces()) // something after the value
+                result.error = JUJSON_ERROR_CODE_UNEXPECTED;
+            if (result.error == JUJSON_ERROR_CODE_SUCCESS) {
+                result.value = builder.release();
+                result.line = range.line;
+                result.column = range.column;
+            } else {
+                result.line = range.line + parser.line();
+                result.column = (parser.line() == 0) ? range.column + parser.column() : parser.column();
             }
-            lastError_ = JUJSON_ERROR_CODE_UNEXPECTED;
-            return json_value_type(); // unknown symbol
         }
 
         public:
-        /// @brief Parses a JSON object from the input. @return The parsed json_value object.
-        [[nodiscard]] json_value_type parse_json_object_expected() {
-            for (auto val = *current_; current_ != end_; ++current_, val = *current_) {
-                if (json_traits::is_object_begin(val)) {
-                    ++current_;
-                    return parse_json_object();
+        /**
+         * @brief Parses all records of the input.
+         * @param threads the number of threads to use, all hardware threads if 0. Ignored with JUJSON_NO_THREADS defined.
+         * @return The records in input order.
+         */
+        [[nodiscard]] container_type parse(unsigned threads = 0) const {
+            const JUJSON_DEFAULT_CONTAINER<record_range> ranges = split();
+            container_type result(ranges.size());
+            parallel::for_each_block((ranges.size() + blockSize - 1) / blockSize, threads, [&](::std::size_t block) {
+                const ::std::size_t last = (::std::min)(ranges.size(), (block + 1) * blockSize);
+                for (::std::size_t i = block * blockSize; i < last; ++i)
+                    parse_record(ranges[i], result[i]);
+            });
+            return result;
+        }
+    };
+#if (JUJSON_HAS_MEMORY_RESOURCE)
+    /**
+     * @brief Arena of json_document: allocates by bumping a pointer in blocks obtained from an upstream resource, deallocation does nothing.
+     *        Unlike std::pmr::monotonic_buffer_resource it can rewind: reset() keeps the blocks for the next document, so parsing documents
+     *        no larger than the previous ones allocates nothing. release() gives the blocks back.
+     */
+    struct json_arena_resource final : ::std::pmr::memory_resource {
+        private:
+        struct block_header { // at the beginning of each block
+            block_header* next;
+            ::std::size_t size; // with the header
+        };
+
+        private:
+        ::std::pmr::memory_resource* upstream_;
+        block_header* first_;
+        block_header* current_; // block allocations are made from, nullptr after reset()
+        char* position_;
+        char* end_;
+        ::std::size_t initialSize_;
+        ::std::size_t nextSize_;
+
+        public:
+        /**
+         * @brief Constructs an empty json_arena_resource.
+         * @param initialSize the size of the first block, next blocks grow geometrically.
+         * @param upstream the memory resource blocks are allocated from.
+         */
+        explicit json_arena_resource(::std::size_t initialSize = 64 * 1024, ::std::pmr::memory_resource* upstream = ::std::pmr::get_default_resource()) noexcept
+            : upstream_(upstream), first_(nullptr), current_(nullptr), position_(nullptr), end_(nullptr), initialSize_((::std::max)(initialSize, sizeof(block_header) * 2)), nextSize_(initialSize_) {
+
+        }
+        json_arena_resource(const json_arena_resource&) = delete;
+        json_arena_resource& operator=(const json_arena_resource&) = delete;
+        ~json_arena_resource() override {
+            release();
+        }
+
+        private:
+        void use(block_header* allocated) noexcept {
+            current_ = allocated;
+            position_ = reinterpret_cast<char*>(allocated + 1);
+            end_ = reinterpret_cast<char*>(allocated) + allocated->size;
+        }
+        void add_block(::std::size_t bytes, ::std::size_t alignment) { // after the last block, which is current_ if any
+            const ::std::size_t size = (::std::max)(nextSize_, sizeof(block_header) + bytes + alignment);
+            block_header* allocated = static_cast<block_header*>(upstream_->allocate(size, alignof(::std::max_align_t)));
+            allocated->next = nullptr;
+            allocated->size = size;
+            if (current_ != nullptr)
+                current_->next = allocated;
+            else
+                first_ = allocated;
+            nextSize_ = size + size / 2;
+            use(allocated);
+        }
+
+        protected:
+        void* do_allocate(::std::size_t bytes, ::std::size_t alignment) override {
+            for (;;) {
+                if (current_ != nullptr) {
+                    void* result = position_;
+                    ::std::size_t space = static_cast<::std::size_t>(end_ - position_);
+                    if (::std::align(alignment, bytes, result, space) != nullptr) {
+                        position_ = static_cast<char*>(result) + bytes;
+                        return result;
+                    }
+                    if (current_->next == nullptr)
+                        break;
+                    use(current_->next); // the rest of a kept block is skipped
+                } else if (first_ != nullptr) {
+                    use(first_);
+                } else {
+                    break;
                 }
-            } // no string litterals
-            lastError_ = JUJSON_ERROR_CODE_EOF;
-            return json_value_type();
+            }
+            add_block(bytes, alignment);
+            void* result = position_;
+            ::std::size_t space = static_cast<::std::size_t>(end_ - position_);
+            result = ::std::align(alignment, bytes, result, space);
+            position_ = static_cast<char*>(result) + bytes;
+            return result;
         }
-        /// @brief Gets the current column position in the input. @return The current column position.
+        void do_deallocate(void*, ::std::size_t, ::std::size_t) override {
+
+        }
+        bool do_is_equal(const ::std::pmr::memory_resource& other) const noexcept override {
+            return this == &other;
+        }
+
+        public:
+        /// @brief Makes all memory available again, keeping the blocks. What was allocated must not be used anymore.
+        void reset() noexcept {
+            current_ = nullptr;
+            position_ = nullptr;
+            end_ = nullptr;
+        }
+        /// @brief Gives the blocks back to the upstream resource. What was allocated must not be used anymore.
+        void release() noexcept {
+            for (block_header* allocated = first_; allocated != nullptr;) {
+                block_header* const next = allocated->next;
+                upstream_->deallocate(allocated, allocated->size, alignof(::std::max_align_t));
+                allocated = next;
+            }
+            first_ = nullptr;
+            reset();
+            nextSize_ = initialSize_;
+        }
+        /// @brief Gets the size of the blocks. @return The number of bytes obtained from the upstream resource.
+        [[nodiscard]] ::std::size_t capacity() const noexcept {
+            ::std::size_t result = 0;
+            for (const block_header* allocated = first_; allocated != nullptr; allocated = allocated->next)
+                result += allocated->size;
+            return result;
+        }
+    };
+    /**
+     * @brief Owns a parsed JSON document whose json_value nodes are carved out of a few large blocks of a json_arena_resource.
+     *        Strings are kept in the arena too if StringT_ is allocator-aware (std::pmr::string) or a view (std::string_view).
+     *        In that case nothing owns memory outside of the arena, and the document is cleared at once, without walking the tree.
+     *        Parsing again reuses the blocks of the previous document: a document kept per thread parses messages without allocating.
+     *        With set_interning(true), keys are stored once in a json_string_pool of the arena, see json_parser::set_string_pool.
+     * @tparam StringT_ the type of the string to use.
+     * @tparam JSONTraitsT_ the traits class used to define JSON-specific characteristics.
+     */
+    template<class StringT_, class JSONTraitsT_ = default_json_traits<typename StringT_::value_type>>
+    struct json_document final {
+        public:
+        typedef ::std::pmr::polymorphic_allocator<char> allocator_type;
+        typedef json_value<StringT_, JSONTraitsT_, allocator_type> json_value_type;
+        typedef json_parser<StringT_, JSONTraitsT_, allocator_type> json_parser_type;
+        typedef typename json_parser_type::const_iterator const_iterator;
+        typedef typename json_parser_type::string_pool_type string_pool_type;
+
+        private:
+        static constexpr bool trivial_teardown_ = ::std::is_trivially_destructible<StringT_>::value || ::std::uses_allocator<StringT_, allocator_type>::value;
+
+        private:
+        json_arena_resource arena_;
+        string_pool_type strings_; // in the arena
+        json_value_type* root_;
+        JUJSON_SIZE_TYPE line_;
+        JUJSON_SIZE_TYPE column_;
+        error_code lastError_;
+        json_parser_options options_;
+        bool interning_;
+
+        public:
+        /**
+         * @brief Constructs an empty json_document.
+         * @param initialSize the size of the first arena block, next blocks grow geometrically.
+         * @param upstream the memory resource arena blocks are allocated from.
+         */
+        explicit json_document(JUJSON_SIZE_TYPE initialSize = 64 * 1024, ::std::pmr::memory_resource* upstream = ::std::pmr::get_default_resource())
+            : arena_(initialSize, upstream), strings_(allocator_type(&arena_)), root_(nullptr), line_(0), column_(0), lastError_(JUJSON_ERROR_CODE_SUCCESS), options_(), interning_(false) {
+
+        }
+        json_document(const json_document&) = delete;
+        json_document& operator=(const json_document&) = delete;
+        ~json_document() {
+            clear();
+        }
+
+        public:
+        /**
+         * @brief Parses a JSON object from the input, replacing the previous content of the document.
+         * @param b the beginning iterator. @param e the ending iterator.
+         * @return The parsed root json_value, invalid on error.
+         */
+        const json_value_type& parse_json_object_expected(const_iterator b, const_iterator e) {
+            clear();
+            json_parser_type parser(b, e, get_allocator());
+            parser.set_options(options_);
+            if (interning_)
+                parser.set_string_pool(&strings_);
+            json_value_type result = parser.parse_json_object_expected();
+            line_ = parser.line();
+            column_ = parser.column();
+            lastError_ = parser.get_last_error();
+            root_ = ::new (arena_.allocate(sizeof(json_value_type), alignof(json_value_type))) json_value_type(JUJSON_MOVE(result), get_allocator());
+            return *root_;
+        }
+        /// @brief Parses a JSON object from the string, replacing the previous content of the document. @param str the string to parse. @return The parsed root json_value, invalid on error.
+        const json_value_type& parse_json_object_expected(const StringT_& str) {
+            return parse_json_object_expected(str.begin(), str.end());
+        }
+        /// @brief Destroys the content of the document, keeping the blocks of the arena for the next parse.
+        void clear() noexcept {
+            if ((root_ != nullptr) && (!trivial_teardown_))
+                root_->~json_value_type();
+            root_ = nullptr;
+            strings_.clear();
+            arena_.reset();
+        }
+        /// @brief Destroys the content of the document and gives the blocks of the arena back.
+        void release() noexcept {
+            clear();
+            arena_.release();
+        }
+        /// @brief Gets the size of the arena, kept across parses. @return The number of bytes of the blocks of the arena.
+        [[nodiscard]] ::std::size_t capacity() const noexcept {
+            return arena_.capacity();
+        }
+        /// @brief Sets the options for the next parsed documents. @param options the options.
+        void set_options(const json_parser_options& options) {
+            options_ = options;
+        }
+        /// @brief Gets the options for parsed documents. @return The options.
+        [[nodiscard]] const json_parser_options& get_options() const noexcept {
+            return options_;
+        }
+        /**
+         * @brief Interns keys of the next parsed documents in a string pool of the arena, and strings up to json_parser_options::internLength.
+         *        With std::string_view all strings are then copied into the arena and the document no longer refers to the input;
+         *        repeated keys of arrays of objects are stored once and compare by address in find.
+         * @param interning true to intern strings.
+         */
+        void set_interning(bool interning) noexcept {
+            interning_ = interning;
+        }
+        /// @brief Gets the number of distinct strings interned by the last parse. @return The number of interned strings.
+        [[nodiscard]] JUJSON_SIZE_TYPE interned_count() const noexcept {
+            return strings_.size();
+        }
+        /// @brief Gets the root json_value. @return A reference to the root json_value, invalid if nothing was parsed.
+        [[nodiscard]] json_value_type& root() {
+            JUJSON_ASSERT(root_ != nullptr);
+            return *root_;
+        }
+        /// @brief Gets the root json_value. @return A reference to the root json_value, invalid if nothing was parsed.
+        [[nodiscard]] const json_value_type& root() const {
+            JUJSON_ASSERT(root_ != nullptr);
+            return *root_;
+        }
+        /// @brief Gets the allocator that allocates from the arena of the document. @return The allocator.
+        [[nodiscard]] allocator_type get_allocator() noexcept {
+            return allocator_type(&arena_);
+        }
+        /// @brief Gets the column position where the last parse stopped. @return The column position.
         [[nodiscard]] JUJSON_SIZE_TYPE column() const {
             return column_;
         }
-        /// @brief Gets the current line position in the input. @return The current line position.
+        /// @brief Gets the line position where the last parse stopped. @return The line position.
         [[nodiscard]] JUJSON_SIZE_TYPE line() const {
             return line_;
         }
@@ -610,5 +6593,6 @@ namespace jujson {
             return lastError_;
         }
     };
+#endif
 };
 #endif // ifndef JUJSON_HPP_
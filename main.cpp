@@ -1,6 +1,12 @@
 #include "jujson.hpp"
 #include <string>
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
 #include <iostream>
+#include <limits>
+#include <sstream>
+#include <vector>
 // >:3 Custom trait
 struct custom_trait {
     public:
@@ -47,7 +53,12 @@ bool default_test() {
     auto nameValue = val.find("name");
     std::string name = ((nameValue != val.get_childs().end()) ? nameValue->value().data() : "ERROR");
     std::cout << name << "\n\n";
-    return (val.to_string() == data) && (name == "JohnDoe");
+    typedef jujson::json_char_classes<jujson::default_json_traits<char>> char_classes;
+    std::string latin1Space = "{\"a\":[1,\xA0 2]}"; // no-break space in Latin-1 locales
+    jujson::json_parser<std::string> latin1Parser(latin1Space);
+    const bool asciiOnly = (char_classes::get(char_classes::table(), '\xA0') == 0) && (char_classes::get(char_classes::table(), '\xE9') == 0) &&
+        !latin1Parser.parse_json_object_expected().is_valid();
+    return (val.to_string() == data) && (name == "JohnDoe") && asciiOnly;
 }
 bool wchar_test() {
     std::cout << "wchar test\n";
@@ -133,7 +144,682 @@ bool custom_type_test() {
         return false;
     }
 }
+// counts strings and stops at the key "spouse"
+struct counting_handler : jujson::json_handler<std::string::const_iterator> {
+    std::size_t strings = 0;
+    std::size_t numbers = 0;
+    bool on_string(std::string::const_iterator, std::string::const_iterator) {
+        ++strings;
+        return true;
+    }
+    bool on_number(std::string::const_iterator, std::string::const_iterator) {
+        ++numbers;
+        return true;
+    }
+    bool on_key(std::string::const_iterator b, std::string::const_iterator e) {
+        return std::string(b, e) != "spouse";
+    }
+};
+bool handler_test() {
+    std::cout << "handler test\n";
+    std::string data = R"({"name":"JohnDoe","age":30,"isEmployed":true,"address":{"street":"123MainSt","city":"Anytown","state":"CA","postalCode":"12345"},"phoneNumbers":[{"type":"home","number":"555-1234"},{"type":"work","number":"555-5678"}],"children":["Jane","Doe"],"spouse":null,"salary":50000.50,"empty":""})";
+    jujson::json_parser<std::string> parser(data);
+    counting_handler handler;
+    const bool parsed = parser.parse(handler);
+    std::cout << handler.strings << " strings, " << handler.numbers << " numbers before spouse\n\n";
+
+    jujson::json_parser<std::string> fullParser(data);
+    auto val = fullParser.parse_json_object_expected();
+    auto emptyKV = val.find("empty");
+    return (!parsed) && (parser.get_last_error() == jujson::JUJSON_ERROR_CODE_ABORTED) && (handler.strings == 11) && (handler.numbers == 1) &&
+        (emptyKV != val.get_childs().end()) && emptyKV->value().data().empty() && (val.to_string() == data);
+}
+bool tape_test() {
+    std::cout << "tape test\n";
+    std::string data = R"({"name":"JohnDoe","age":30,"isEmployed":true,"address":{"street":"123MainSt","city":"Anytown","state":"CA","postalCode":"12345"},"phoneNumbers":[{"type":"home","number":"555-1234"},{"type":"work","number":"555-5678"}],"children":["Jane","Doe"],"spouse":null,"salary":50000.50,"projects":[{"name":"ProjectAlpha","status":"completed","team":["Alice","Bob","Charlie"]},{"name":"ProjectBeta","status":"inprogress","team":["David","Eve"]}]})";
+    jujson::json_parser<std::string> parser(data);
+
+    auto tape = parser.parse_json_tape_expected();
+    if (!tape.is_valid())
+        return false;
+    auto root = tape.root();
+    auto projectsKV = root.find("projects");
+    if (projectsKV == root.get_childs().end())
+        return false;
+    std::size_t teamSize = 0;
+    for (const auto& project : projectsKV->value().get_childs()) {
+        auto teamKV = project.find("team");
+        if (teamKV != project.get_childs().end()) {
+            for (const auto& member : teamKV->value().get_childs())
+                std::cout << member.data() << ' ';
+            teamSize += std::distance(teamKV->value().get_childs().begin(), teamKV->value().get_childs().end());
+        }
+    }
+    std::cout << "\n\n";
+    std::string written;
+    jujson::json_string_sink<std::string> sink(written);
+    jujson::json_writer<jujson::json_string_sink<std::string>>(sink).write(root);
+    return (teamSize == 5) && (tape.to_value().to_string() == data) && (written == data) && (root.find("missing") == root.get_childs().end());
+}
+bool push_test() {
+    std::cout << "push test\n";
+    std::string data = R"({"name":"John\"Doe","age":30,"isEmployed":true,"courses":["Math","Science"],"salary":-50000.50e1})";
+    for (std::size_t chunk = 1; chunk <= data.size(); ++chunk) {
+        jujson::json_push_parser<std::string> parser;
+        jujson::push_status status = jujson::JUJSON_PUSH_STATUS_NEED_MORE;
+        for (std::size_t pos = 0; (pos < data.size()) && (status == jujson::JUJSON_PUSH_STATUS_NEED_MORE); pos += chunk)
+            status = parser.feed(data.data() + pos, std::min(chunk, data.size() - pos));
+        if ((status != jujson::JUJSON_PUSH_STATUS_COMPLETE) || (parser.finish() != jujson::JUJSON_PUSH_STATUS_COMPLETE) || (parser.release().to_string() != data))
+            return false;
+    }
+    jujson::json_push_parser<std::string> number;
+    const bool numberComplete = (number.feed("12") == jujson::JUJSON_PUSH_STATUS_NEED_MORE) && (number.feed("3") == jujson::JUJSON_PUSH_STATUS_NEED_MORE) &&
+        (number.finish() == jujson::JUJSON_PUSH_STATUS_COMPLETE) && (number.release().data() == "123");
+    jujson::json_push_parser<std::string> broken;
+    broken.feed("{\"a\":\n[1,");
+    const bool brokenReported = (broken.feed("?]}") == jujson::JUJSON_PUSH_STATUS_ERROR) && (broken.get_last_error() == jujson::JUJSON_ERROR_CODE_UNEXPECTED) &&
+        (broken.line() == 1) && (broken.column() == 3);
+    jujson::json_push_parser<std::string> truncated;
+    truncated.feed("[\"abc");
+    const bool truncatedReported = (truncated.finish() == jujson::JUJSON_PUSH_STATUS_ERROR) && (truncated.get_last_error() == jujson::JUJSON_ERROR_CODE_EOF);
+    jujson::json_push_parser<std::string> reused;
+    reused.feed("{\"a\":[1,?");
+    reused.reset();
+    const bool reusedAfterError = (reused.feed("{\"b\":2}") == jujson::JUJSON_PUSH_STATUS_COMPLETE) && (reused.release().to_string() == "{\"b\":2}");
+    std::cout << "\n";
+    return numberComplete && brokenReported && truncatedReported && reusedAfterError;
+}
+bool batch_test() {
+    std::cout << "batch test\n";
+    std::string lines;
+    for (int i = 0; i < 1000; ++i)
+        lines += (i == 700) ? "{\"id\":700,\"name\" \"x\"}\n\n" : "{\"id\":" + std::to_string(i) + ",\"tags\":[\"a\",\"b\\n\"]}\n";
+    const auto records = jujson::json_batch_parser<std::string>(lines).parse(4);
+    bool ordered = (records.size() == 1000);
+    for (std::size_t i = 0; ordered && (i < records.size()); ++i) {
+        if (i != 700)
+            ordered = (records[i].error == jujson::JUJSON_ERROR_CODE_SUCCESS) && (records[i].value.find("id")->value().data() == std::to_string(i));
+    }
+    std::cout << "record 700: " << records[700].line << ':' << records[700].column << ':' << " error " << records[700].error << '\n';
+    const bool errorReported = (records[700].error == jujson::JUJSON_ERROR_CODE_UNEXPECTED) && (records[700].line == 700) && (records[700].column == 17) &&
+        (records[701].line == 702); // the blank line is skipped
+
+    std::string concatenated = "{\"a\":\"}{\"}\n[1,\n2] \"s\" {\"b\":\n{}}";
+    const auto documents = jujson::json_batch_parser<std::string>(concatenated, jujson::JUJSON_BATCH_FORMAT_CONCATENATED).parse();
+    std::cout << "\n";
+    return ordered && errorReported && (documents.size() == 4) && (documents[0].value.to_string() == "{\"a\":\"}{\"}") && (documents[1].value.get_childs().size() == 2) &&
+        (documents[2].value.data() == "s") && (documents[3].line == 2) && (documents[3].column == 7) && (documents[3].error == jujson::JUJSON_ERROR_CODE_SUCCESS);
+}
+bool parallel_array_test() {
+    std::cout << "parallel array test\n";
+    std::string data = "[";
+    for (int i = 0; i < 1000; ++i)
+        data += std::string((i == 0) ? "" : ",\n") + "{\"id\":" + std::to_string(i) + ",\"text\":\"a,]\\\"[}\",\"list\":[1,[2,{\"x\":null}]]}";
+    data += "]";
+    jujson::json_parser<std::string> sequentialParser(data);
+    jujson::json_value_builder<jujson::json_value<std::string>> builder;
+    sequentialParser.parse(builder);
+    const auto sequential = builder.release();
+    jujson::json_parser<std::string> parser(data);
+    const auto val = parser.parse_json_array_parallel(4);
+    const bool same = (val.get_childs().size() == 1000) && (val.to_string() == sequential.to_string()) &&
+        (parser.line() == sequentialParser.line()) && (parser.column() == sequentialParser.column());
+
+    std::string broken = "[{\"a\":\"\\n\"},\n {\"b\":1 2}, 3]";
+    jujson::json_parser<std::string> brokenParser(broken);
+    const bool brokenReported = !brokenParser.parse_json_array_parallel(4).is_valid() && (brokenParser.get_last_error() == jujson::JUJSON_ERROR_CODE_UNEXPECTED) &&
+        (brokenParser.line() == 1) && (brokenParser.column() == 8);
+    std::cout << "error at " << brokenParser.line() << ':' << brokenParser.column() << "\n\n";
+    return same && brokenReported;
+}
+bool key_index_test() {
+    std::cout << "key index test\n";
+    std::string data = "{";
+    for (int i = 0; i < 1000; ++i)
+        data += "\"key" + std::to_string(i) + "\":" + std::to_string(i) + ",";
+    data += "\"key7\":\"duplicate\"}";
+    jujson::json_parser<std::string> parser(data);
+    auto val = parser.parse_json_object_expected();
+    bool found = true;
+    for (int i = 0; found && (i < 1000); ++i) {
+        const std::string key = "key" + std::to_string(i);
+        auto kv = val.find(key.c_str());
+        found = (kv != val.get_childs().end()) && (kv->value().data() == std::to_string(i));
+    }
+    const bool firstOfDuplicates = (val.find("key7")->value().data() == "7") && (val.find("key1000") == val.get_childs().end());
+
+    val.add_child(jujson::json_value<std::string>("added", jujson::JUSJON_JSON_VALUE_KEY));
+    val.get_childs().back().add_child(jujson::json_value<std::string>("true", jujson::JUSJON_JSON_VALUE_TRUE));
+    const auto copy = val;
+    const bool updated = (val.find(std::string("added")) != val.get_childs().end()) && (copy.find("added")->value().kind() == jujson::JUSJON_JSON_VALUE_TRUE);
+    val.get_childs().erase(val.get_childs().begin()); // same number of childs, other keys
+    val.get_childs().push_back(jujson::json_value<std::string>("zz", jujson::JUSJON_JSON_VALUE_KEY));
+    val.get_childs().back().add_child(jujson::json_value<std::string>("null", jujson::JUSJON_JSON_VALUE_NULL));
+    const bool edited = (val.find("key1") == val.get_childs().begin()) && (val.find("zz") != val.get_childs().end()) && (val.find("key0") == val.get_childs().end());
+    std::string small = "{";
+    for (int i = 0; i < 20; ++i)
+        small += std::string((i == 0) ? "" : ",") + "\"k" + std::to_string(i) + "\":" + std::to_string(i);
+    small += "}";
+    jujson::json_parser<std::string> smallParser(small);
+    auto renamedVal = smallParser.parse_json_object_expected();
+    renamedVal.build_key_index();
+    const auto renamedKV = renamedVal.find("k3");
+    *renamedKV = jujson::json_value<std::string>("renamed", jujson::JUSJON_JSON_VALUE_KEY);
+    const bool renamed = (renamedVal.find("renamed") == renamedKV) && (renamedVal.find("k3") == renamedVal.get_childs().end());
+
+    jujson::json_parser_options options;
+    options.keyIndex = true;
+    jujson::json_parser<std::string> eagerParser(data);
+    eagerParser.set_options(options);
+    const auto eager = eagerParser.parse_json_object_expected();
+    std::cout << eager.find("key999")->value().data() << "\n\n";
+#if (JUJSON_HAS_MEMORY_RESOURCE)
+    jujson::json_document<std::pmr::string> document; // the index is allocated from the arena
+    const auto& root = document.parse_json_object_expected(std::pmr::string(data));
+    const bool viewFound = (root.find(std::string_view("key500"))->value().data() == "500");
+
+    struct counting_resource final : std::pmr::memory_resource {
+        std::size_t allocations = 0;
+        void* do_allocate(std::size_t bytes, std::size_t alignment) override {
+            ++allocations;
+            return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+        }
+        void do_deallocate(void* p, std::size_t bytes, std::size_t alignment) override {
+            std::pmr::new_delete_resource()->deallocate(p, bytes, alignment);
+        }
+        bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override {
+            return this == &other;
+        }
+    } resource;
+    const std::pmr::string counted(data, &resource);
+    jujson::json_parser<std::pmr::string, jujson::default_json_traits<char>, std::pmr::polymorphic_allocator<char>> countedParser(counted, &resource);
+    auto countedVal = countedParser.parse_json_object_expected();
+    const std::size_t allocations = resource.allocations;
+    bool indexedOnce = true;
+    for (int i = 0; indexedOnce && (i < 1000); ++i) // non-const lookups build the index once
+        indexedOnce = (countedVal.find(("key" + std::to_string(i)).c_str()) != countedVal.get_childs().end());
+    indexedOnce = indexedOnce && (resource.allocations - allocations <= 2);
+#else
+    const bool viewFound = true;
+    const bool indexedOnce = true;
+#endif
+    return found && firstOfDuplicates && updated && edited && renamed && viewFound && indexedOnce && (eager.find("key999")->value().data() == "999");
+}
+bool number_test() {
+    std::cout << "number test\n";
+    std::string data = R"({"age":30,"negative":-9223372036854775808,"big":18446744073709551615,"salary":50000.50,"tiny":1e-5,"precise":0.30000000000000004,"huge":1.5E+300})";
+    jujson::json_parser<std::string> parser(data);
+    const auto val = parser.parse_json_object_expected();
+    const bool decoded = val.find("age")->value().is_integer() && (val.find("age")->value().as_int64() == 30) &&
+        (val.find("negative")->value().as_int64() == INT64_MIN) && (val.find("big")->value().as_uint64() == UINT64_MAX) &&
+        !val.find("salary")->value().is_integer() && (val.find("salary")->value().as_double() == 50000.5) && (val.find("tiny")->value().as_double() == 1e-5) &&
+        (val.find("precise")->value().as_double() == 0.30000000000000004) && (val.find("huge")->value().as_double() == 1.5e300) && (val.to_string() == data);
+
+    jujson::json_parser_options options;
+    options.numberText = false;
+    jujson::json_parser<std::string> numbersOnlyParser(data);
+    numbersOnlyParser.set_options(options);
+    const auto numbersOnly = numbersOnlyParser.parse_json_object_expected();
+    const auto& salary = numbersOnly.find("salary")->value();
+    std::cout << numbersOnly.to_string() << "\n\n";
+    const std::string longText = "1" + std::string(79, '0') + ".0"; // longer than the stack buffer
+    const std::wstring wideText(longText.begin(), longText.end());
+    const bool longDecoded = (jujson::decode_json_number<jujson::default_json_traits<char>>(longText.begin(), longText.end()).as_double() == 1e79) &&
+        (jujson::decode_json_number<jujson::default_json_traits<wchar_t>>(wideText.begin(), wideText.end()).as_double() == 1e79);
+    std::string overflowing = R"({"a":1e400,"b":-1e400})";
+    jujson::json_parser<std::string> overflowingParser(overflowing);
+    overflowingParser.set_options(options);
+    const std::string infinite = overflowingParser.parse_json_object_expected().to_string();
+    jujson::json_parser<std::string> infiniteParser(infinite);
+    const bool infinityWritten = (infinite == R"({"a":1e999,"b":-1e999})") &&
+        (infiniteParser.parse_json_object_expected().find("b")->value().as_double() == -std::numeric_limits<double>::infinity());
+    return decoded && longDecoded && infinityWritten && salary.data().empty() && (salary.as_double() == 50000.5) && (numbersOnly.find("precise")->value().to_string() == "0.30000000000000004") &&
+        (numbersOnly.find("negative")->value().to_string() == "-9223372036854775808");
+}
+bool writer_test() {
+    std::cout << "writer test\n";
+    std::string data = R"({"name":"John\"Doe","empty":[],"nothing":{},"courses":["Math","Science"],"age":30})";
+    jujson::json_parser<std::string> parser(data);
+    const auto val = parser.parse_json_object_expected();
+    const bool compact = (val.to_string() == data) && (jujson::json_writer<jujson::json_string_sink<std::string>>::size(val) == data.size());
+
+    jujson::json_writer_options options;
+    options.indent = 2;
+    std::string pretty;
+    jujson::json_string_sink<std::string> stringSink(pretty);
+    jujson::json_writer<jujson::json_string_sink<std::string>>(stringSink, options).write(val);
+    std::cout << pretty << '\n';
+    const bool prettyWritten = (pretty == "{\n  \"name\": \"John\\\"Doe\",\n  \"empty\": [],\n  \"nothing\": {},\n  \"courses\": [\n    \"Math\",\n    \"Science\"\n  ],\n  \"age\": 30\n}") &&
+        (jujson::json_writer<jujson::json_string_sink<std::string>>::size(val, options) == pretty.size());
+
+    std::string flushed;
+    std::size_t flushes = 0;
+    auto flush = [&](const char* b, std::size_t size) { flushed.append(b, size); ++flushes; };
+    jujson::json_buffer_sink<char, decltype(flush)> bufferSink(flush, 16);
+    jujson::json_writer<jujson::json_buffer_sink<char, decltype(flush)>>(bufferSink).write(val);
+    std::ostringstream stream;
+    jujson::json_ostream_sink<char> streamSink(stream);
+    jujson::json_writer<jujson::json_ostream_sink<char>>(streamSink).write(val);
+
+    const std::string raw = "tab\tquote\"slash\\\x01";
+    const std::string escaped = jujson::escape_json_string<std::string>(raw.begin(), raw.end());
+    std::cout << escaped << "\n\n";
+    return compact && prettyWritten && (flushed == data) && (flushes > 1) && (stream.str() == data) && (escaped == "tab\\tquote\\\"slash\\\\\\u0001") &&
+        (jujson::unescape_json_string<std::string, jujson::default_json_traits<char>>(escaped.begin(), escaped.end()) == raw);
+}
+bool lazy_test() {
+    std::cout << "lazy test\n";
+    std::string data = R"({"name":"JohnDoe","address":{"street":"123MainSt","city":"Anytown"},"projects":[{"name":"ProjectAlpha","team":["Alice","Bob"]}],"age":30})";
+    jujson::json_parser_options options;
+    options.lazy = true;
+    jujson::json_parser<std::string> parser(data);
+    parser.set_options(options);
+    const auto val = parser.parse_json_object_expected();
+    const auto& address = val.find("address")->value();
+    const auto& projects = val.find("projects")->value();
+    const bool skipped = val.is_parsed() && !address.is_parsed() && !projects.is_parsed() && (address.kind() == jujson::JUSJON_JSON_VALUE_OBJECT);
+    const auto cityKV = address.find("city"); // parses the address only
+    const bool accessed = address.is_parsed() && !projects.is_parsed() && (cityKV->value().data() == "Anytown") && projects.decoded_data().empty();
+    std::cout << val.to_string() << "\n\n";
+
+    const std::string invalid = R"({"name":"JohnDoe",
+"projects":[{"name":"ProjectAlpha","team":["Alice" "Bob"]}]})";
+    jujson::json_parser<std::string> invalidParser(invalid);
+    invalidParser.set_options(options);
+    const bool validated = !invalidParser.parse_json_object_expected().is_valid() && (invalidParser.get_last_error() == jujson::JUJSON_ERROR_CODE_UNEXPECTED) &&
+        (invalidParser.line() == 1) && (invalidParser.column() == 51);
+    return skipped && accessed && projects.get_childs()[0].find("team")->value().get_childs()[1].data() == "Bob" && (val.to_string() == data) && validated;
+}
+bool query_test() {
+    std::cout << "query test\n";
+    std::string data = R"({"name":"JohnDoe","a/b":1,"projects":[{"name":"ProjectAlpha","team":["Alice","Bob"]},{"name":"ProjectBeta","team":["David","Eve"]}],"address":{"city":"Anytown"}})";
+    const jujson::json_query<std::string> query = {"/projects/*/team/0", "address", "/a~1b", "/missing", "projects.1.name"};
+    jujson::json_parser<std::string> parser(data);
+    std::string selected;
+    const bool parsed = query.select(parser, [&](std::size_t path, const jujson::json_value<std::string>& value) {
+        selected += std::to_string(path) + '=' + value.to_string() + ';';
+        return true;
+    });
+    std::cout << selected << "\n\n";
+
+    jujson::json_query<std::string> invalidQuery;
+    const bool invalidRejected = !invalidQuery.add("/projects/~2") && !invalidQuery.add("projects..name") && !invalidQuery.is_valid();
+    return parsed && query.is_valid() && (query.size() == 5) && invalidRejected &&
+        (selected == R"(2=1;0="Alice";4="ProjectBeta";0="David";1={"city":"Anytown"};)");
+}
+namespace company {
+struct address {
+    std::string street;
+    std::string city;
+};
+JUJSON_BIND(address, street, city)
+struct project {
+    std::string name;
+    std::vector<std::string> team;
+};
+JUJSON_BIND(project, name, team)
+struct employee {
+    std::string name;
+    int age = 0;
+    bool isEmployed = false;
+    double salary = 0.0;
+    std::uint64_t id = 0;
+    address home;
+    std::vector<project> projects;
+};
+JUJSON_BIND(employee, name, age, isEmployed, salary, id, home, projects)
+struct wide_employee {
+    std::wstring name;
+    std::vector<int> scores;
+};
+JUJSON_BIND(wide_employee, name, scores)
+struct checklist {
+    std::vector<bool> done;
+    std::vector<std::vector<bool>> grid;
+};
+JUJSON_BIND(checklist, done, grid)
+}
+bool bind_test() {
+    std::cout << "bind test\n";
+    std::string data = R"({"name":"John\"Doe","age":30,"isEmployed":true,"spouse":null,"salary":50000.5,"id":18446744073709551615,"home":{"street":"123MainSt","city":"Anytown"},"projects":[{"name":"ProjectAlpha","team":["Alice","Bob"]},{"name":"ProjectBeta","team":[]}]})";
+    company::employee employee;
+    jujson::json_parser<std::string> parser(data);
+    const bool parsed = parser.parse_into(employee) && (employee.name == "John\"Doe") && (employee.age == 30) && employee.isEmployed && (employee.salary == 50000.5) &&
+        (employee.id == UINT64_MAX) && (employee.home.city == "Anytown") && (employee.projects.size() == 2) && (employee.projects[0].team[1] == "Bob");
+    const std::string written = jujson::bound_to_string<std::string>(employee);
+    std::cout << written << "\n\n";
+
+    const std::string mismatched = R"({"name":"JohnDoe","age":"thirty"})";
+    company::employee other;
+    jujson::json_parser<std::string> mismatchParser(mismatched);
+    const bool mismatch = !mismatchParser.parse_into(other) && (mismatchParser.get_last_error() == jujson::JUJSON_ERROR_CODE_TYPE_MISMATCH) && (other.name == "JohnDoe");
+
+    std::wstring wideData = L"{\"scores\":[1,2,3],\"name\":\"John\\tDoe\"}";
+    company::wide_employee wide;
+    jujson::json_parser<std::wstring> wideParser(wideData);
+    const bool wideParsed = wideParser.parse_into(wide) && (wide.name == L"John\tDoe") && (wide.scores.size() == 3) &&
+        (jujson::bound_to_string<std::wstring>(wide) == L"{\"name\":\"John\\tDoe\",\"scores\":[1,2,3]}");
+
+    const std::string checklistData = R"({"done":[true,false,null,true],"grid":[[true],[]]})";
+    company::checklist checklist;
+    jujson::json_parser<std::string> checklistParser(checklistData);
+    const bool bits = checklistParser.parse_into(checklist) && (checklist.done == std::vector<bool>{true, false, false, true}) && (checklist.grid.size() == 2) &&
+        (jujson::bound_to_string<std::string>(checklist) == R"({"done":[true,false,false,true],"grid":[[true],[]]})");
+    return parsed && (written == data.substr(0, data.find(",\"spouse\"")) + data.substr(data.find(",\"salary\""))) && mismatch && wideParsed && bits;
+}
+bool mapped_file_test() {
+    std::cout << "mapped file test\n";
+    std::string data = R"({"name":"JohnDoe","courses":["Math","Science"],"age":30})";
+    const char* path = "jujson_mapped_file_test.json";
+    {
+        std::ofstream file(path, std::ios::binary);
+        file << data;
+    }
+    jujson::json_mapped_file mapped(path);
+    jujson::json_mapped_file read(path, false);
+    const jujson::json_mapped_file missing("jujson_missing_file_test.json");
+    bool result = mapped.is_open() && read.is_open() && !read.is_mapped() && !missing.is_open() &&
+        (std::string(mapped.begin(), mapped.end()) == data) && (std::string(read.begin(), read.end()) == data);
+#if (JUJSON_HAS_STRING_VIEW)
+    jujson::json_parser<std::string_view> parser(mapped.view()); // values refer to the mapping
+    const auto val = parser.parse_json_object_expected();
+    result = result && (val.to_string() == data) && (val.find("name")->value().data().data() >= mapped.data());
+#else
+    jujson::json_push_parser<std::string> parser;
+    result = result && (parser.feed(mapped.data(), mapped.size()) != jujson::JUJSON_PUSH_STATUS_ERROR) && (parser.finish() == jujson::JUJSON_PUSH_STATUS_COMPLETE) &&
+        (parser.release().to_string() == data);
+#endif
+    jujson::json_mapped_file moved(std::move(mapped));
+    result = result && moved.is_open() && !mapped.is_open() && (moved.size() == data.size());
+    moved.close();
+    read.close();
+    std::remove(path);
+    std::cout << (result ? "parsed" : "ERROR") << "\n\n";
+    return result;
+}
+#if (JUJSON_HAS_STRING_VIEW)
+bool string_view_test() {
+    std::cout << "string_view test\n";
+    std::string data = R"({"name":"John\tDoe","emoji":"\ud83d\ude00","courses":["Math","Science"],"age":30})";
+    jujson::json_parser<std::string_view> parser(data);
+
+    auto val = parser.parse_json_object_expected();
+    auto nameKV = val.find("name");
+    auto emojiKV = val.find("emoji");
+    if ((nameKV == val.get_childs().end()) || (emojiKV == val.get_childs().end()))
+        return false;
+    const std::string_view name = nameKV->value().data(); // refers to data
+    std::cout << nameKV->value().decoded_data() << "\n\n";
+    return (val.to_string() == data) && (name.data() >= data.data()) && (name.data() < data.data() + data.size()) &&
+        (name == "John\\tDoe") && (nameKV->value().decoded_data() == "John\tDoe") && (emojiKV->value().decoded_data() == "\xF0\x9F\x98\x80");
+}
+#else
+bool string_view_test() {
+    return true;
+}
+#endif
+#if (JUJSON_HAS_MEMORY_RESOURCE)
+bool document_test() {
+    std::cout << "document test\n";
+    std::string data = R"({"name":"JohnDoe","age":30,"isEmployed":true,"address":{"street":"123MainSt","city":"Anytown","state":"CA","postalCode":"12345"},"phoneNumbers":[{"type":"home","number":"555-1234"},{"type":"work","number":"555-5678"}],"children":["Jane","Doe"],"spouse":null,"salary":50000.50,"projects":[{"name":"ProjectAlpha","status":"completed","team":["Alice","Bob","Charlie"]},{"name":"ProjectBeta","status":"inprogress","team":["David","Eve"]}]})";
+
+    jujson::json_document<std::string_view> viewDocument;
+    jujson::json_document<std::pmr::string> stringDocument(256);
+    bool result = true;
+    for (int i = 0; i < 3; ++i) { // reparsing reuses the arena of the previous document
+        const auto& viewRoot = viewDocument.parse_json_object_expected(data);
+        const auto& stringRoot = stringDocument.parse_json_object_expected(std::pmr::string(data));
+        result = result && (viewRoot.to_string() == data) && (stringRoot.to_string<std::string>() == data);
+    }
+    auto nameKV = stringDocument.root().find("name");
+    std::cout << ((nameKV != stringDocument.root().get_childs().end()) ? nameKV->value().data() : "ERROR") << "\n\n";
+    return result && (nameKV != stringDocument.root().get_childs().end()) && (nameKV->value().data() == "JohnDoe");
+}
+#else
+bool document_test() {
+    return true;
+}
+#endif
+bool position_test() {
+    std::cout << "position test\n";
+    const std::string broken = "prefix\n{\"a\":[1, 2],\n \"b\":\"x\\\"\\ny\",\n  \"c\": tru }";
+    typedef jujson::json_parser<std::string, jujson::default_json_traits<char>, std::allocator<char>, jujson::json_eager_position> eager_parser;
+    eager_parser eager(broken);
+    jujson::json_parser<std::string> fast(broken); // json_lazy_position, counted from the input on demand
+    const bool failed = !eager.parse_json_object_expected().is_valid() && !fast.parse_json_object_expected().is_valid();
+    std::cout << "error at " << eager.line() << ':' << eager.column() << " and " << fast.line() << ':' << fast.column() << "\n\n";
+    const bool same = (eager.line() == 2) && (eager.column() == 10) && (fast.line() == eager.line()) && (fast.column() == eager.column());
+
+    const std::wstring values = L"[\"\u00e9\"]\n  {\"k\":\n null}"; // two values parsed one after another
+    jujson::json_parser<std::wstring> wideParser(values);
+    jujson::json_value_builder<jujson::json_value<std::wstring>> first;
+    jujson::json_value_builder<jujson::json_value<std::wstring>> second;
+    const bool wideParsed = wideParser.parse(first) && (wideParser.column() == 5) && wideParser.parse(second) && (wideParser.line() == 2) && (wideParser.column() == 6);
+    return failed && same && wideParsed;
+}
+bool binary_test() {
+    std::cout << "binary test\n";
+    std::string data = R"({"name":"John\"Doe","age":30,"id":18446744073709551615,"salary":-5e1,"isEmployed":true,"spouse":null,"courses":["Math",[],{}],"address":{"city":"Anytown"}})";
+    jujson::json_parser<std::string> parser(data);
+    const std::string snapshot = jujson::encode_json_binary(parser.parse_json_object_expected());
+
+    jujson::json_binary_view<std::string, jujson::default_json_traits<char>> view(snapshot.data(), snapshot.size());
+    const auto root = view.root();
+    const auto idKV = root.find("id");
+    const auto coursesKV = root.find("courses");
+    const bool viewed = view.is_valid() && (idKV != root.get_childs().end()) && (idKV->value().number().u == UINT64_MAX) &&
+        (coursesKV->value().size() == 3) && (root.find("name")->value().decoded_data() == "John\"Doe") && (root.find("missing") == root.get_childs().end());
+    const auto decoded = jujson::decode_json_binary<jujson::json_value<std::string>>(snapshot.data(), snapshot.size());
+    std::cout << decoded.to_string() << "\n\n";
+
+    std::string corrupted = snapshot;
+    corrupted[32 + 24 + 16] = 99; // next sibling of the first key
+    jujson::json_binary_view<std::string, jujson::default_json_traits<char>> rejected(corrupted.data(), corrupted.size() - 1);
+    const bool truncated = !rejected.is_valid() && (rejected.get_last_error() == jujson::JUJSON_ERROR_CODE_INVALID_BINARY);
+    const bool corrupt = !rejected.open(corrupted.data(), corrupted.size()) && !jujson::decode_json_binary<jujson::json_value<std::string>>(corrupted.data(), corrupted.size()).is_valid();
+
+    const std::wstring wideData = L"{\"a\":[1.5,\"\u00e9\"],\"k\":false}";
+    jujson::json_parser<std::wstring> wideParser(wideData);
+    const std::string wideSnapshot = jujson::encode_json_binary(wideParser.parse_json_object_expected());
+    const bool wide = (jujson::decode_json_binary<jujson::json_value<std::wstring>>(wideSnapshot.data(), wideSnapshot.size()).to_string() == wideData) &&
+        !jujson::json_binary_view<std::string, jujson::default_json_traits<char>>(wideSnapshot.data(), wideSnapshot.size()).is_valid(); // code units differ
+    return viewed && (decoded.to_string() == data) && (decoded.find("salary")->value().number().d == -50.0) && truncated && corrupt && wide;
+}
+bool intern_test() {
+    std::cout << "intern test\n";
+    std::string data = R"({"people":[{"name":"Alice","team":"red","bio":"likes long walks"},{"name":"Bob","team":"red","bio":null},{"name":"Alice","team":"blue","bio":""}]})";
+    jujson::json_string_pool<char> strings;
+    jujson::json_parser_options options;
+    options.internLength = 8;
+    jujson::json_parser<std::string> parser(data);
+    parser.set_options(options);
+    parser.set_string_pool(&strings);
+    const auto val = parser.parse_json_object_expected();
+    bool result = (val.to_string() == data) && (strings.size() == 9); // people, name, team, bio, Alice, red, Bob, blue and null
+#if (JUJSON_HAS_MEMORY_RESOURCE)
+    jujson::json_document<std::string_view> document;
+    document.set_interning(true);
+    std::string copy = data;
+    const auto& root = document.parse_json_object_expected(copy);
+    copy.assign(copy.size(), ' '); // the document refers to its pool, not to the input
+    const auto& people = root.find("people")->value().get_childs();
+    result = result && (root.to_string() == data) && (document.interned_count() == 5) &&
+        (people[0].find("name")->data().data() == people[2].find("name")->data().data()) && (people[1].find("bio")->value().kind() == jujson::JUSJON_JSON_VALUE_NULL);
+#endif
+    std::cout << (result ? "interned" : "ERROR") << "\n\n";
+    return result;
+}
+bool compact_test() {
+    std::cout << "compact test\n";
+    std::string data = R"({"name":"John\"Doe","age":30,"id":18446744073709551615,"salary":50000.50,"isEmployed":true,"spouse":null,"courses":["Math","Computer Science",[],{}],"address":{"city":"Anytown"}})";
+    jujson::json_parser<std::string> parser(data);
+    const auto tree = parser.parse_json_compact_expected();
+    const auto root = tree.root();
+    const auto courses = root.find("courses")->value();
+    std::string written;
+    jujson::json_string_sink<std::string> sink(written);
+    jujson::json_writer<jujson::json_string_sink<std::string>>(sink).write(root);
+    std::cout << written << "\n\n";
+    const bool accessed = tree.is_valid() && (sizeof(jujson::json_compact_node<char>) == 16) && (root.size() == 8) && (root.child(1).data() == "age") &&
+        (root.find("id")->value().number().u == UINT64_MAX) && (root.find("name")->value().decoded_data() == "John\"Doe") &&
+        (courses.size() == 4) && (courses.child(1).data() == "Computer Science") && (courses.child(3).kind() == jujson::JUSJON_JSON_VALUE_OBJECT) &&
+        (root.find("missing") == root.get_childs().end()) && (tree.to_value().find("salary")->value().number().d == 50000.5);
+
+    const std::wstring wideData = L"{\"a\":[1.5,\"\u00e9\"],\"keylonger\":false}";
+    jujson::json_parser<std::wstring> wideParser(wideData);
+    const bool wide = (wideParser.parse_json_compact_expected().to_value().to_string() == L"{\"a\":[1.5,\"\u00e9\"],\"keylonger\":false}");
+    bool viewed = true;
+#if (JUJSON_HAS_STRING_VIEW)
+    std::string copy = data;
+    jujson::json_parser<std::string_view> viewParser(copy);
+    const auto viewTree = viewParser.parse_json_compact_expected();
+    copy.assign(copy.size(), ' '); // the tree owns its strings
+    viewed = (viewTree.root().find("courses")->value().child(1).data() == "Computer Science");
+#endif
+    return accessed && (written == std::string(R"({"name":"John\"Doe","age":30,"id":18446744073709551615,"salary":50000.5,"isEmployed":true,"spouse":null,"courses":["Math","Computer Science",[],{}],"address":{"city":"Anytown"}})")) && wide && viewed;
+}
+bool depth_test() {
+    std::cout << "depth test\n";
+    const std::string deep = "{\"a\":" + std::string(200000, '[') + std::string(200000, ']') + "}";
+    jujson::json_parser<std::string> limited(deep);
+    const bool rejected = !limited.parse_json_tape_expected().is_valid() && (limited.get_last_error() == jujson::JUJSON_ERROR_CODE_DEPTH);
+    jujson::json_parser_options options;
+    options.maxDepth = 0;
+    jujson::json_parser<std::string> unlimited(deep);
+    unlimited.set_options(options);
+    const bool parsed = (unlimited.parse_json_tape_expected().nodes().size() == 200002); // no native stack per level
+
+    options.maxDepth = 2;
+    std::string shallow = R"({"a":[1,2]})";
+    jujson::json_parser<std::string> shallowParser(shallow);
+    shallowParser.set_options(options);
+    std::string nested = R"({"a":[1,[{}]]})";
+    jujson::json_parser<std::string> nestedParser(nested);
+    nestedParser.set_options(options);
+    std::string array = "[[1],[2],[[3]]]";
+    jujson::json_parser<std::string> arrayParser(array);
+    arrayParser.set_options(options);
+    const bool limit = (shallowParser.parse_json_object_expected().to_string() == shallow) && !nestedParser.parse_json_object_expected().is_valid() &&
+        (nestedParser.get_last_error() == jujson::JUJSON_ERROR_CODE_DEPTH) && (nestedParser.column() == 7) &&
+        !arrayParser.parse_json_array_parallel(2).is_valid() && (arrayParser.get_last_error() == jujson::JUJSON_ERROR_CODE_DEPTH);
+    jujson::json_push_parser<std::string> pushed; // from a socket, one chunk
+    const bool pushRejected = (pushed.feed(deep.data(), deep.size()) == jujson::JUJSON_PUSH_STATUS_ERROR) && (pushed.get_last_error() == jujson::JUJSON_ERROR_CODE_DEPTH);
+    jujson::json_push_parser<std::string> shallowPushed(jujson::json_value_builder<jujson::json_value<std::string>>(), options);
+    jujson::json_push_parser<std::string> nestedPushed(jujson::json_value_builder<jujson::json_value<std::string>>(), options);
+    const bool pushLimit = (shallowPushed.feed(shallow.data(), shallow.size()) == jujson::JUJSON_PUSH_STATUS_COMPLETE) &&
+        (nestedPushed.feed(nested.data(), nested.size()) == jujson::JUJSON_PUSH_STATUS_ERROR) && (nestedPushed.get_last_error() == jujson::JUJSON_ERROR_CODE_DEPTH) &&
+        (nestedPushed.column() == 8);
+    std::cout << (rejected && parsed && limit && pushRejected && pushLimit ? "limited" : "ERROR") << "\n\n";
+    return rejected && parsed && limit && pushRejected && pushLimit;
+}
+bool reuse_test() {
+    std::cout << "reuse test\n";
+    const std::string messages[] = {R"({"id":1,"name":"Alice","tags":["a","b"]})", R"({"id":2,"tags":[1,)", R"({"id":3,"nested":{"list":[[1],[2,3]]}})"};
+    jujson::json_parser<std::string> parser(messages[0]);
+    bool result = true;
+    for (int i = 0; i < 6; ++i) { // one parser for all messages, as good as a new one
+        const std::string& message = messages[i % 3];
+        parser.reset(message);
+        const auto val = parser.parse_json_object_expected();
+        jujson::json_parser<std::string> fresh(message);
+        const auto expected = fresh.parse_json_object_expected();
+        result = result && (val.is_valid() == expected.is_valid()) && (parser.get_last_error() == fresh.get_last_error()) && (parser.column() == fresh.column()) &&
+            (!val.is_valid() || (val.to_string() == message));
+    }
+#if (JUJSON_HAS_MEMORY_RESOURCE)
+    jujson::json_document<std::string_view> document(256);
+    document.set_interning(true);
+    for (const auto& message : messages)
+        document.parse_json_object_expected(message);
+    const std::size_t capacity = document.capacity();
+    for (int i = 0; i < 30; ++i) { // the blocks of the previous messages are enough
+        const std::string& message = messages[i % 3];
+        const auto& root = document.parse_json_object_expected(message);
+        result = result && (root.is_valid() ? (root.to_string() == message) : (document.get_last_error() == jujson::JUJSON_ERROR_CODE_EOF));
+    }
+    result = result && (capacity != 0) && (document.capacity() == capacity);
+    document.release();
+    result = result && (document.capacity() == 0) && (document.parse_json_object_expected(messages[0]).to_string() == messages[0]);
+#endif
+    std::cout << (result ? "reused" : "ERROR") << "\n\n";
+    return result;
+}
+bool encoding_test() {
+    std::cout << "encoding test\n";
+    const std::string ascii(100, 'a'); // long enough for the 32 bytes blocks
+    const std::string valid = ascii + "\xC3\xA9\xE2\x82\xAC\xF0\x9F\x98\x80\xF4\x8F\xBF\xBF" + ascii;
+    const char* const invalid[] = {"\xC0\x80", "\xE0\x80\x80", "\xED\xA0\x80", "\xF4\x90\x80\x80", "\xF5", "\x80", "\xE2\x82", "\xF0\x9F\x98"};
+    bool result = (jujson::find_invalid_encoding(valid.begin(), valid.end()) == valid.end());
+    for (const char* sequence : invalid) { // found where it begins, in a block or in the tail
+        const std::string text = ascii + sequence + "\xC3\xA9" + ascii;
+        const std::string tail = ascii + sequence;
+        result = result && (jujson::find_invalid_encoding(text.begin(), text.end()) - text.begin() == 100) && (jujson::find_invalid_encoding(tail.begin(), tail.end()) - tail.begin() == 100);
+    }
+    const std::wstring wide = L"a\u00e9" + std::wstring(1, static_cast<wchar_t>(0xDC00)) + L"b";
+    result = result && (jujson::find_invalid_encoding(wide.begin(), wide.end()) - wide.begin() == 2); // a lone surrogate in UTF-16 and in UTF-32
+
+    const std::string escaped = R"(a\"b\\c\/d\b\f\n\r\t\u00e9\uD83D\uDE00\uD83D-\u12)";
+    const std::string decoded = jujson::unescape_json_string<std::string, jujson::default_json_traits<char>>(escaped.begin(), escaped.end());
+    result = result && (decoded == "a\"b\\c/d\b\f\n\r\t\xC3\xA9\xF0\x9F\x98\x80\xED\xA0\xBD-\\u12"); // a lone surrogate is still encoded, a malformed escape kept
+    const std::wstring wideEscaped = LR"(x\u00e9\ty)";
+    result = result && (jujson::unescape_json_string<std::wstring, jujson::default_json_traits<wchar_t>>(wideEscaped.begin(), wideEscaped.end()) == L"x\u00e9\ty");
+
+    const std::string broken = "{\"a\":\"ok\",\"b\":\"xx\\\"\xC0\x80\"}";
+    jujson::json_parser_options options;
+    options.validateEncoding = true;
+    typedef jujson::json_parser<std::string, jujson::default_json_traits<char>, std::allocator<char>, jujson::json_eager_position> eager_parser;
+    eager_parser eager(broken);
+    eager.set_options(options);
+    jujson::json_parser<std::string> fast(broken);
+    fast.set_options(options);
+    jujson::json_parser<std::string> lenient(broken); // not checked by default
+    const bool rejected = !eager.parse_json_object_expected().is_valid() && (eager.get_last_error() == jujson::JUJSON_ERROR_CODE_INVALID_ENCODING) &&
+        !fast.parse_json_object_expected().is_valid() && (fast.get_last_error() == jujson::JUJSON_ERROR_CODE_INVALID_ENCODING) &&
+        (eager.column() == 17) && (fast.column() == 17) && lenient.parse_json_object_expected().is_valid();
+    const std::string text = "{\"" + valid + "\":[\"\\u00e9\xC3\xA9\"]}";
+    jujson::json_parser<std::string> checked(text);
+    checked.set_options(options);
+    const bool parsed = (checked.parse_json_object_expected().to_string() == text);
+    std::cout << (result && rejected && parsed ? "validated" : "ERROR") << "\n\n";
+    return result && rejected && parsed;
+}
+bool patch_test() {
+    std::cout << "patch test\n";
+    typedef jujson::json_value<std::string> value_type;
+    const std::string data = R"({"a":{"x":1,"list":[1,2]},"b":{"y":"s\"q","z":[true,null]},"c":[{"k":1},{"k":2}]})";
+    value_type doc = jujson::json_parser<std::string>(data).parse_json_object_expected();
+    const value_type& view = doc; // const access keeps the kept text
+    const bool cached = (doc.to_string_cached(0) == data) && doc.has_cached_text() && view.find("b")->value().has_cached_text() && (doc.to_string_cached(0) == data) && view.data().empty();
+
+    const std::string operations = R"([{"op":"replace","path":"/a/x","value":{"n":[3]}},{"op":"add","path":"/a/list/-","value":4},{"op":"remove","path":"/c/0"},
+        {"op":"test","path":"/b/y","value":"s\"q"},{"op":"copy","from":"/b/z","path":"/a/z"},{"op":"move","from":"/c/0/k","path":"/c/0/m"}])";
+    jujson::json_parser<std::string> patchParser(operations);
+    jujson::json_value_builder<value_type> builder;
+    const bool parsed = patchParser.parse(builder);
+    const value_type patch = builder.release();
+    const bool applied = parsed && (jujson::apply_json_patch(doc, patch) == jujson::JUJSON_ERROR_CODE_SUCCESS);
+    const std::string expected = R"({"a":{"x":{"n":[3]},"list":[1,2,4],"z":[true,null]},"b":{"y":"s\"q","z":[true,null]},"c":[{"m":2}]})";
+    const bool dirty = !doc.has_cached_text() && !view.find("a")->value().has_cached_text() && view.find("b")->value().has_cached_text(); // only the changed paths
+    const std::string text = doc.to_string_cached(0);
+    std::cout << text << "\n\n";
+    const bool rewritten = (text == expected) && (doc.to_string() == expected) && doc.has_cached_text();
+
+    value_type& list = doc.find("c")->get_childs()[0]; // a reference kept across writes
+    const bool shared = (doc.to_string_cached(1) == doc.to_string()) && !doc.has_cached_text() && list.has_cached_text() && view.find("b")->value().has_cached_text();
+    list.add_child(value_type("3", jujson::JUSJON_JSON_VALUE_NUMBER));
+    const bool changed = shared && (doc.to_string_cached(1) == doc.to_string()) && (doc.to_string().find("[{\"m\":2},3]") != std::string::npos);
+    const std::string failingOperations = R"([{"op":"test","path":"/b/z/0","value":false},{"op":"remove","path":"/b/nope"}])";
+    jujson::json_parser<std::string> failingParser(failingOperations);
+    jujson::json_value_builder<value_type> failingBuilder;
+    const bool failingParsed = failingParser.parse(failingBuilder);
+    value_type failing = failingBuilder.release();
+    const bool failed = failingParsed && (jujson::apply_json_patch(doc, failing) == jujson::JUJSON_ERROR_CODE_TEST_FAILED) &&
+        (failing.get_childs().erase(failing.get_childs().begin()), jujson::apply_json_patch(doc, failing) == jujson::JUJSON_ERROR_CODE_INVALID_PATCH);
+    doc.clear_cached_text();
+    const bool cleared = !doc.has_cached_text() && !view.find("b")->value().has_cached_text() && (doc.to_string_cached(0) == doc.to_string()) && doc.has_cached_text();
+    return cached && applied && dirty && rewritten && changed && failed && cleared;
+}
 int main() {
-    std::cout << (int)default_test() + (int)wchar_test() + (int)accessing() + (int)custom_type_test();
+    std::cout << (int)default_test() + (int)wchar_test() + (int)accessing() + (int)custom_type_test() + (int)string_view_test() + (int)document_test() + (int)tape_test() + (int)handler_test() + (int)push_test() + (int)batch_test() + (int)parallel_array_test() + (int)key_index_test() + (int)number_test() + (int)writer_test() + (int)mapped_file_test() + (int)lazy_test() + (int)query_test() + (int)bind_test() + (int)position_test() + (int)binary_test() + (int)intern_test() + (int)compact_test() + (int)depth_test() + (int)reuse_test() + (int)encoding_test() + (int)patch_test();
     return 0;
 }